@@ -38,11 +38,20 @@ AppTime::AppTime()
 
 bool AppTime::hasTestTime() const
 {
-  return m_testStartTime.has_value();
+  return m_testStartTime.has_value() || s_virtualClock;
 }
 
-time_point AppTime::now()
+void AppTime::setVirtualClock(NowFunc nowFunc)
 {
+  s_virtualClock = std::move(nowFunc);
+}
+
+time_point AppTime::now() const
+{
+  if (s_virtualClock) {
+    return s_virtualClock();
+  }
+
   if (m_testStartTime.has_value()) {
     const auto runtime = system_clock::now() - m_realStartTime;
     return time_point{m_testStartTime.value()} + runtime;
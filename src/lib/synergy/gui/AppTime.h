@@ -18,6 +18,7 @@
 #pragma once
 
 #include <chrono>
+#include <functional>
 #include <optional>
 
 namespace synergy::gui {
@@ -25,13 +26,22 @@ namespace synergy::gui {
 class AppTime
 {
   using time_point = std::chrono::system_clock::time_point;
+  using NowFunc = std::function<time_point()>;
 
 public:
   AppTime();
-  time_point now();
+  time_point now() const;
   bool hasTestTime() const;
 
+  /**
+   * @brief Makes every `AppTime` follow a simulated clock, or the real one again if empty.
+   *
+   * Only for tests and simulations; set it before anything reads the time.
+   */
+  static void setVirtualClock(NowFunc nowFunc);
+
 private:
+  inline static NowFunc s_virtualClock;
   std::optional<std::chrono::seconds> m_testStartTime = std::nullopt;
   time_point m_realStartTime = std::chrono::system_clock::now();
 };
@@ -17,9 +17,14 @@
 
 #include "ExtraSettings.h"
 
+#include "synergy/gui/constants.h"
+#include "synergy/gui/license/LicenseMetrics.h"
+
+#include <QFileInfo>
 #include <QSettings>
 #include <QtCore>
 
+using namespace std::chrono;
 using namespace deskflow::gui::proxy;
 
 namespace synergy::gui {
@@ -27,27 +32,212 @@ namespace synergy::gui {
 const auto kSerialKeySettingKey = "serialKey";
 const auto kActivatedSettingKey = "activated";
 const auto kGraceStartSettingKey = "graceStartEpochSecs";
+const auto kLeaseSettingKey = "lease";
+const auto kLastCheckSettingKey = "lastCheckEpochSecs";
+const auto kCheckIntervalSettingKey = "checkIntervalSecs";
+const auto kRelayEnabledSettingKey = "licenseRelayEnabled";
+const auto kRelayAddressSettingKey = "licenseRelayAddress";
+const auto kRelayUrlSettingKey = "licenseRelayUrl";
+const auto kOptimisticStartSettingKey = "licenseOptimisticStart";
+const auto kStatusSocketSettingKey = "licenseStatusSocket";
+
+ExtraSettings::Transaction::Transaction(ExtraSettings &settings) : m_settings(settings)
+{
+  m_settings.m_transactionDepth++;
+}
+
+ExtraSettings::Transaction::~Transaction()
+{
+  m_settings.m_transactionDepth--;
+  m_settings.requestSync();
+}
+
+ExtraSettings::ExtraSettings()
+{
+  m_syncTimer.setSingleShot(true);
+  m_syncTimer.setInterval(duration_cast<milliseconds>(kSettingsSyncDelay));
+  connect(&m_syncTimer, &QTimer::timeout, this, &ExtraSettings::sync);
+}
+
+ExtraSettings::~ExtraSettings()
+{
+  sync();
+}
 
 void ExtraSettings::load()
 {
-  const auto &settings = getActiveSettings();
-  m_serialKey = settings.value(kSerialKeySettingKey).toString();
-  m_activated = settings.value(kActivatedSettingKey).toBool();
-  m_graceStartEpochSecs = settings.value(kGraceStartSettingKey).toLongLong();
+  // Otherwise changes not yet written would be lost.
+  sync();
+
+  apply(read(getActiveSettings(), std::move(m_stateFile), m_adminSettings));
+}
+
+QString ExtraSettings::activeFileName()
+{
+  return getActiveSettings().fileName();
+}
+
+QSettings::Format ExtraSettings::activeFormat()
+{
+  return getActiveSettings().format();
+}
+
+ExtraSettings::Snapshot ExtraSettings::read(const QString &fileName, QSettings::Format format)
+{
+  // The active settings object belongs to the GUI thread, so this thread parses the file itself.
+  const QSettings settings(fileName, format);
+  return read(settings, nullptr, {});
+}
+
+ExtraSettings::Snapshot ExtraSettings::read(
+    const QSettings &settings, std::unique_ptr<license::LicenseStateFile> stateFile, const AdminSettings &cached
+)
+{
+  Snapshot snapshot;
+  snapshot.licenseState = readLicenseState(settings, stateFile);
+  snapshot.stateFile = std::move(stateFile);
+  snapshot.adminSettings = readAdminSettings(settings, cached);
+  return snapshot;
+}
+
+void ExtraSettings::apply(Snapshot snapshot)
+{
+  m_stateFile = std::move(snapshot.stateFile);
+  m_serialKey = snapshot.licenseState.serialKey;
+  m_activated = snapshot.licenseState.activated;
+  m_graceStartEpochSecs = snapshot.licenseState.graceStartEpochSecs;
+  m_lease = snapshot.licenseState.lease;
+  m_lastCheckEpochSecs = snapshot.licenseState.lastCheckEpochSecs;
+  m_adminSettings = std::move(snapshot.adminSettings);
+  m_dirty = 0;
+}
+
+ExtraSettings::AdminSettings ExtraSettings::readAdminSettings(const QSettings &settings, const AdminSettings &cached)
+{
+  // Admins rarely change these, so only read them again when the settings file has.
+  const QFileInfo info(settings.fileName());
+  const auto modified = info.lastModified();
+  if (info.absoluteFilePath() == cached.path && modified == cached.modified) {
+    return cached;
+  }
+
+  return {
+      .path = info.absoluteFilePath(),
+      .modified = modified,
+      .checkIntervalSecs = settings.value(kCheckIntervalSettingKey).toLongLong(),
+      .relayEnabled = settings.value(kRelayEnabledSettingKey).toBool(),
+      .relayAddress = settings.value(kRelayAddressSettingKey).toString(),
+      .relayUrl = settings.value(kRelayUrlSettingKey).toString(),
+      .optimisticStart = settings.value(kOptimisticStartSettingKey).toBool(),
+      .statusSocket = settings.value(kStatusSocketSettingKey).toString(),
+  };
+}
+
+license::LicenseStateFile::State ExtraSettings::readLicenseState(
+    const QSettings &settings, std::unique_ptr<license::LicenseStateFile> &stateFile
+)
+{
+  // The scope can change between loads, and each scope has its own state file.
+  const auto path = license::LicenseStateFile::pathFor(settings.fileName());
+  if (stateFile == nullptr || stateFile->path() != path) {
+    stateFile = std::make_unique<license::LicenseStateFile>(path);
+    if (!stateFile->open()) {
+      qWarning("license state file unavailable, using settings file");
+      stateFile.reset();
+    }
+  }
+
+  if (stateFile != nullptr) {
+    if (auto state = stateFile->read(); state.has_value()) {
+      return std::move(*state);
+    }
+  }
+
+  // Versions before the state file kept it all in the settings file. Those keys are left
+  // in place, and the serial key and activation are kept up to date there (see `sync`).
+  license::LicenseStateFile::State state{
+      settings.value(kSerialKeySettingKey).toString(), settings.value(kActivatedSettingKey).toBool(),
+      settings.value(kGraceStartSettingKey).toLongLong(), settings.value(kLeaseSettingKey).toString(),
+      settings.value(kLastCheckSettingKey).toLongLong()
+  };
+
+  if (stateFile != nullptr && stateFile->write(state)) {
+    qInfo().noquote() << "moved license state to:" << stateFile->path();
+  }
+  return state;
+}
+
+license::LicenseStateFile::State ExtraSettings::licenseState() const
+{
+  return {m_serialKey, m_activated, m_graceStartEpochSecs, m_lease, m_lastCheckEpochSecs};
 }
 
 void ExtraSettings::sync()
+{
+  if (m_dirty == 0) {
+    return;
+  }
+
+  m_syncTimer.stop();
+
+  QElapsedTimer timer;
+  timer.start();
+
+  if (m_stateFile == nullptr) {
+    if (syncToSettingsFile(m_dirty)) {
+      m_dirty = 0;
+    }
+  } else if (m_stateFile->write(licenseState())) {
+    // An older version run after this one only reads the settings file, so it still needs
+    // the current serial key, which changes rarely. The rest can go stale there, and the
+    // older version then just checks the license again.
+    if (const auto fields = m_dirty & (kSerialKeyField | kActivatedField); fields != 0) {
+      syncToSettingsFile(fields);
+    }
+    m_dirty = 0;
+  } else {
+    qCritical().noquote() << "unable to save license state to:" << m_stateFile->path();
+  }
+
+  license::LicenseMetrics::instance().recordSettingsSync(microseconds{timer.nsecsElapsed() / 1000});
+}
+
+bool ExtraSettings::syncToSettingsFile(unsigned fields)
 {
   auto &settings = getActiveSettings();
   if (!settings.isWritable()) {
     qCritical() << "unable to save to settings, file not writable:" << settings.fileName();
-    return;
+    return false;
+  }
+
+  if (fields & kSerialKeyField) {
+    settings.setValue(kSerialKeySettingKey, m_serialKey);
+  }
+  if (fields & kActivatedField) {
+    settings.setValue(kActivatedSettingKey, m_activated);
+  }
+  if (fields & kGraceStartField) {
+    settings.setValue(kGraceStartSettingKey, m_graceStartEpochSecs);
+  }
+  if (fields & kLeaseField) {
+    settings.setValue(kLeaseSettingKey, m_lease);
+  }
+  if (fields & kLastCheckField) {
+    settings.setValue(kLastCheckSettingKey, m_lastCheckEpochSecs);
   }
 
-  settings.setValue(kSerialKeySettingKey, m_serialKey);
-  settings.setValue(kActivatedSettingKey, m_activated);
-  settings.setValue(kGraceStartSettingKey, m_graceStartEpochSecs);
   settings.sync();
+  return true;
+}
+
+void ExtraSettings::requestSync()
+{
+  // The end of the transaction asks again.
+  if (m_dirty == 0 || m_transactionDepth > 0) {
+    return;
+  }
+
+  m_syncTimer.start();
 }
 
 } // namespace synergy::gui
@@ -18,29 +18,114 @@
 #pragma once
 
 #include "gui/config/Settings.h"
+#include "synergy/gui/license/LicenseStateFile.h"
 
+#include <QDateTime>
 #include <QSettings>
 #include <QString>
+#include <QTimer>
 #include <QUuid>
 
+#include <memory>
+
 namespace synergy::gui {
 
 class ExtraSettings : public deskflow::gui::Settings
 {
   Q_OBJECT
 public:
-  ExtraSettings() = default;
-  virtual ~ExtraSettings() = default;
+  /**
+   * @brief Holds back syncing until it ends, so a burst of changes is one disk write.
+   */
+  class Transaction
+  {
+  public:
+    explicit Transaction(ExtraSettings &settings);
+    ~Transaction();
+
+    Transaction(const Transaction &) = delete;
+    Transaction &operator=(const Transaction &) = delete;
+
+  private:
+    ExtraSettings &m_settings;
+  };
+
+  /**
+   * @brief Set by admins; read only, and read again only when the settings file changes.
+   */
+  struct AdminSettings
+  {
+    QString path;
+    QDateTime modified;
+    qint64 checkIntervalSecs = 0;
+    bool relayEnabled = false;
+    QString relayAddress;
+    QString relayUrl;
+    bool optimisticStart = false;
+    QString statusSocket;
+  };
+
+  /**
+   * @brief Everything `load` reads from disk, handed from the thread that read it to this one.
+   *
+   * The state file is opened by the reader too; it only maps the file and never uses events,
+   * so it works from whichever thread applies it.
+   */
+  struct Snapshot
+  {
+    std::unique_ptr<license::LicenseStateFile> stateFile;
+    license::LicenseStateFile::State licenseState;
+    AdminSettings adminSettings;
+  };
+
+  ExtraSettings();
+  ~ExtraSettings() override;
   void load();
+
+  /**
+   * @brief Reads what `load` does through a `QSettings` of its own, so unlike `load` it can
+   *    run on another thread. The result is then given to `apply` on this object's thread.
+   *
+   * The file name and format come from `activeFileName` and `activeFormat`.
+   */
+  static Snapshot read(const QString &fileName, QSettings::Format format);
+  void apply(Snapshot snapshot);
+  QString activeFileName();
+  QSettings::Format activeFormat();
+
+  /**
+   * @brief Writes changed values to disk straight away, e.g. on shutdown.
+   */
   void sync();
 
+  /**
+   * @brief Writes changed values to disk soon, once any other changes have been made.
+   *
+   * Each sync rewrites the whole settings file, which can stall on network profiles.
+   */
+  void requestSync();
+
+  bool isDirty() const
+  {
+    return m_dirty != 0;
+  }
+
+  /**
+   * @brief Forgets changes that another process has already saved.
+   */
+  void markSaved()
+  {
+    m_dirty = 0;
+    m_syncTimer.stop();
+  }
+
   QString serialKey() const
   {
     return m_serialKey;
   }
   void setSerialKey(const QString &serialKey)
   {
-    m_serialKey = serialKey;
+    update(m_serialKey, serialKey, kSerialKeyField);
   }
 
   bool activated() const
@@ -49,7 +134,7 @@ public:
   }
   void setActivated(bool activated)
   {
-    m_activated = activated;
+    update(m_activated, activated, kActivatedField);
   }
 
   qint64 graceStartEpochSecs() const
@@ -58,13 +143,102 @@ public:
   }
   void setGraceStartEpochSecs(qint64 epochSecs)
   {
-    m_graceStartEpochSecs = epochSecs;
+    update(m_graceStartEpochSecs, epochSecs, kGraceStartField);
+  }
+
+  QString lease() const
+  {
+    return m_lease;
+  }
+  void setLease(const QString &lease)
+  {
+    update(m_lease, lease, kLeaseField);
+  }
+
+  qint64 lastCheckEpochSecs() const
+  {
+    return m_lastCheckEpochSecs;
+  }
+  void setLastCheckEpochSecs(qint64 epochSecs)
+  {
+    update(m_lastCheckEpochSecs, epochSecs, kLastCheckField);
+  }
+
+  /// Read only, set by admins to change how often business licenses are checked.
+  /// Zero means use the default interval.
+  qint64 checkIntervalSecs() const
+  {
+    return m_adminSettings.checkIntervalSecs;
+  }
+
+  /// Read only, set by admins on the server machine to answer client license checks.
+  bool relayEnabled() const
+  {
+    return m_adminSettings.relayEnabled;
+  }
+
+  /// Read only, set by admins on the server machine; the interface the relay listens on.
+  QString relayAddress() const
+  {
+    return m_adminSettings.relayAddress;
+  }
+
+  /// Read only, set by admins on client machines to check licenses via the server.
+  QString relayUrl() const
+  {
+    return m_adminSettings.relayUrl;
+  }
+
+  /// Read only, set by admins to start the core while activation is still in flight.
+  bool optimisticStart() const
+  {
+    return m_adminSettings.optimisticStart;
+  }
+
+  /// Read only, set by admins so monitoring agents can read the license status.
+  QString statusSocket() const
+  {
+    return m_adminSettings.statusSocket;
   }
 
 private:
+  enum Field : unsigned
+  {
+    kSerialKeyField = 1 << 0,
+    kActivatedField = 1 << 1,
+    kGraceStartField = 1 << 2,
+    kLeaseField = 1 << 3,
+    kLastCheckField = 1 << 4
+  };
+
+  template <typename T> void update(T &member, const T &value, Field field)
+  {
+    if (member != value) {
+      member = value;
+      m_dirty |= field;
+    }
+  }
+
+  static Snapshot read(
+      const QSettings &settings, std::unique_ptr<license::LicenseStateFile> stateFile, const AdminSettings &cached
+  );
+  static license::LicenseStateFile::State readLicenseState(
+      const QSettings &settings, std::unique_ptr<license::LicenseStateFile> &stateFile
+  );
+  static AdminSettings readAdminSettings(const QSettings &settings, const AdminSettings &cached);
+  license::LicenseStateFile::State licenseState() const;
+  bool syncToSettingsFile(unsigned fields);
+
+  std::unique_ptr<license::LicenseStateFile> m_stateFile;
+  unsigned m_dirty = 0;
+  int m_transactionDepth = 0;
+  QTimer m_syncTimer;
   QString m_serialKey;
   bool m_activated = false;
   qint64 m_graceStartEpochSecs = 0;
+  QString m_lease;
+  qint64 m_lastCheckEpochSecs = 0;
+  AdminSettings m_adminSettings;
 };
 
 } // namespace synergy::gui
@@ -57,7 +57,7 @@ bool FeatureHandler::checkSettingsScopeLicense(
     QDialog *parent, QRadioButton *systemScope, QRadioButton *userScope, bool showDialog
 ) const
 {
-  const auto &licenseHandler = LicenseHandler::instance();
+  auto &licenseHandler = LicenseHandler::instance();
   if (!licenseHandler.isEnabled()) {
     qDebug("license handler disabled, skipping settings scope check");
     return true;
@@ -0,0 +1,223 @@
+/*
+ * Synergy -- mouse and keyboard sharing utility
+ * Copyright (C) 2026 Symless Ltd.
+ *
+ * This package is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * found in the file LICENSE that should have accompanied this file.
+ *
+ * This package is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "StallWatchdog.h"
+
+#include "gui/string_utils.h"
+#include "synergy/gui/constants.h"
+
+#include <QCoreApplication>
+#include <QtCore>
+
+#include <algorithm>
+#include <optional>
+
+using namespace std::chrono;
+
+namespace synergy::gui {
+
+namespace {
+
+// Scopes are marked on the GUI thread and read by the watchdog thread.
+std::atomic_bool g_watching = false;
+std::mutex g_scopeMutex;
+const char *g_scopeName = nullptr;
+steady_clock::time_point g_scopeStart;
+
+long long toMillis(milliseconds duration)
+{
+  return static_cast<long long>(duration.count());
+}
+
+const char *scopeLabel(const char *scope)
+{
+  return scope != nullptr ? scope : "(unmarked)";
+}
+
+} // namespace
+
+StallWatchdog::Scope::Scope(const char *name)
+{
+  if (!g_watching.load(std::memory_order_relaxed)) {
+    return;
+  }
+
+  std::scoped_lock lock(g_scopeMutex);
+  m_marked = true;
+  m_previousName = g_scopeName;
+  m_previousStart = g_scopeStart;
+  g_scopeName = name;
+  g_scopeStart = steady_clock::now();
+}
+
+StallWatchdog::Scope::~Scope()
+{
+  if (!m_marked) {
+    return;
+  }
+
+  std::scoped_lock lock(g_scopeMutex);
+  g_scopeName = m_previousName;
+  g_scopeStart = m_previousStart;
+}
+
+StallWatchdog::StallWatchdog(milliseconds interval, milliseconds threshold, QObject *parent)
+    : QObject(parent),
+      m_interval(interval),
+      m_threshold(threshold)
+{
+  m_heartbeatTimer.setInterval(m_interval);
+  connect(&m_heartbeatTimer, &QTimer::timeout, this, [this] {
+    m_heartbeat.store(now().time_since_epoch().count(), std::memory_order_relaxed);
+  });
+}
+
+StallWatchdog::~StallWatchdog()
+{
+  stop();
+}
+
+bool StallWatchdog::isEnabled()
+{
+  return strToTrue(qEnvironmentVariable("SYNERGY_STALL_WATCHDOG"));
+}
+
+void StallWatchdog::startForApp()
+{
+  static StallWatchdog *watchdog = nullptr;
+  if (watchdog != nullptr || !isEnabled() || QCoreApplication::instance() == nullptr) {
+    return;
+  }
+
+  qInfo(
+      "starting gui stall watchdog, interval: %lld ms, threshold: %lld ms", toMillis(kStallWatchdogInterval),
+      toMillis(kStallThreshold)
+  );
+  watchdog = new StallWatchdog(kStallWatchdogInterval, kStallThreshold, QCoreApplication::instance());
+  connect(QCoreApplication::instance(), &QCoreApplication::aboutToQuit, watchdog, &StallWatchdog::stop);
+  watchdog->start();
+}
+
+void StallWatchdog::start()
+{
+  if (m_thread.joinable()) {
+    return;
+  }
+
+  m_stopping = false;
+  m_heartbeat.store(now().time_since_epoch().count(), std::memory_order_relaxed);
+  m_heartbeatTimer.start();
+  g_watching = true;
+  m_thread = std::thread(&StallWatchdog::watch, this);
+}
+
+void StallWatchdog::stop()
+{
+  if (!m_thread.joinable()) {
+    return;
+  }
+
+  {
+    std::scoped_lock lock(m_mutex);
+    m_stopping = true;
+  }
+  m_stopped.notify_all();
+  m_thread.join();
+
+  m_heartbeatTimer.stop();
+  g_watching = false;
+  logSummary();
+}
+
+StallWatchdog::Summary StallWatchdog::summary() const
+{
+  std::scoped_lock lock(m_mutex);
+  return m_summary;
+}
+
+void StallWatchdog::watch()
+{
+  std::optional<Stall> stall;
+  steady_clock::rep stallBeat = 0;
+
+  std::unique_lock lock(m_mutex);
+  while (!m_stopped.wait_for(lock, m_interval, [this] { return m_stopping; })) {
+    lock.unlock();
+
+    const auto beat = m_heartbeat.load(std::memory_order_relaxed);
+    const auto beatTime = steady_clock::time_point(steady_clock::duration(beat));
+    if (stall.has_value() && beat != stallBeat) {
+      stall->duration = duration_cast<milliseconds>(steady_clock::duration(beat - stallBeat));
+      qInfo("gui event loop stall ended after %lld ms, in: %s", toMillis(stall->duration), scopeLabel(stall->scope));
+      record(*stall);
+      stall.reset();
+    } else if (!stall.has_value() && now() - beatTime > m_threshold) {
+      stall = Stall{};
+      stallBeat = beat;
+      {
+        std::scoped_lock scopeLock(g_scopeMutex);
+        stall->scope = g_scopeName;
+        if (g_scopeName != nullptr) {
+          stall->scopeAge = duration_cast<milliseconds>(now() - g_scopeStart);
+        }
+      }
+      qWarning(
+          "gui event loop stalled for over %lld ms, in: %s (running for %lld ms)", toMillis(m_threshold),
+          scopeLabel(stall->scope), toMillis(stall->scopeAge)
+      );
+    }
+
+    lock.lock();
+  }
+
+  if (stall.has_value()) {
+    const auto beatTime = steady_clock::time_point(steady_clock::duration(stallBeat));
+    stall->duration = duration_cast<milliseconds>(now() - beatTime);
+    lock.unlock();
+    record(*stall);
+  }
+}
+
+void StallWatchdog::record(const Stall &stall)
+{
+  std::scoped_lock lock(m_mutex);
+  m_summary.count++;
+  m_summary.total += stall.duration;
+
+  auto &worst = m_summary.worst;
+  const auto position = std::find_if(worst.begin(), worst.end(), [&stall](const Stall &other) {
+    return stall.duration > other.duration;
+  });
+  worst.insert(position, stall);
+  if (worst.size() > static_cast<std::size_t>(kMaxReportedStalls)) {
+    worst.pop_back();
+  }
+}
+
+void StallWatchdog::logSummary() const
+{
+  const auto stalls = summary();
+  qInfo("gui stall watchdog summary, stalls: %d, total: %lld ms", stalls.count, toMillis(stalls.total));
+  for (const auto &stall : stalls.worst) {
+    qInfo(
+        "gui stall: %lld ms, in: %s (running for %lld ms)", toMillis(stall.duration), scopeLabel(stall.scope),
+        toMillis(stall.scopeAge)
+    );
+  }
+}
+
+} // namespace synergy::gui
@@ -0,0 +1,125 @@
+/*
+ * Synergy -- mouse and keyboard sharing utility
+ * Copyright (C) 2026 Symless Ltd.
+ *
+ * This package is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * found in the file LICENSE that should have accompanied this file.
+ *
+ * This package is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <QObject>
+#include <QTimer>
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace synergy::gui {
+
+/**
+ * @brief Notices when the GUI event loop stops turning, and says what was running.
+ *
+ * A timer on the GUI thread stamps a heartbeat, and a thread of its own checks that
+ * the heartbeat keeps moving. If it stops for longer than the threshold, the stall
+ * is logged from the watchdog thread straight away, so there's a log line even while
+ * the GUI is frozen, along with the innermost `Scope` that was active on the GUI
+ * thread and how long it had been. When it's stopped, the watchdog logs a summary of
+ * the stall count and the worst stalls.
+ *
+ * Modal dialogs run a nested event loop, which keeps the heartbeat moving, so they
+ * only show up here if something inside them blocks.
+ *
+ * Opt in with `SYNERGY_STALL_WATCHDOG=true`.
+ */
+class StallWatchdog : public QObject
+{
+  Q_OBJECT
+
+public:
+  /**
+   * @brief Marks code running on the GUI thread, so a stall can be blamed on it.
+   *
+   * Costs one atomic load when the watchdog isn't running.
+   */
+  class Scope
+  {
+  public:
+    explicit Scope(const char *name);
+    ~Scope();
+
+    Scope(const Scope &) = delete;
+    Scope &operator=(const Scope &) = delete;
+
+  private:
+    bool m_marked = false;
+    const char *m_previousName = nullptr;
+    std::chrono::steady_clock::time_point m_previousStart;
+  };
+
+  struct Stall
+  {
+    const char *scope = nullptr;
+    std::chrono::milliseconds scopeAge{0};
+    std::chrono::milliseconds duration{0};
+  };
+
+  struct Summary
+  {
+    int count = 0;
+    std::chrono::milliseconds total{0};
+    std::vector<Stall> worst;
+  };
+
+  explicit StallWatchdog(
+      std::chrono::milliseconds interval, std::chrono::milliseconds threshold, QObject *parent = nullptr
+  );
+  ~StallWatchdog() override;
+
+  static bool isEnabled();
+
+  /**
+   * @brief Starts a watchdog for the app if enabled, stopping it when the app quits.
+   *
+   * Must be called on the GUI thread once the app exists; later calls do nothing.
+   */
+  static void startForApp();
+
+  void start();
+  void stop();
+  Summary summary() const;
+
+private:
+  void watch();
+  void record(const Stall &stall);
+  void logSummary() const;
+
+  static std::chrono::steady_clock::time_point now()
+  {
+    return std::chrono::steady_clock::now();
+  }
+
+  const std::chrono::milliseconds m_interval;
+  const std::chrono::milliseconds m_threshold;
+  QTimer m_heartbeatTimer;
+  std::atomic<std::chrono::steady_clock::rep> m_heartbeat = 0;
+  std::thread m_thread;
+  mutable std::mutex m_mutex;
+  std::condition_variable m_stopped;
+  bool m_stopping = false;
+  Summary m_summary;
+};
+
+} // namespace synergy::gui
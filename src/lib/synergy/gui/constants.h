@@ -23,6 +23,10 @@
 
 namespace synergy::gui {
 
+// As set by the GUI at startup; these name the dirs its per-user data goes in.
+const auto kGuiOrganizationName = DESKFLOW_APP_NAME;
+const auto kGuiApplicationName = DESKFLOW_APP_NAME;
+
 const auto kProProductName = "Synergy 1 Pro";
 const auto kBusinessProductName = "Synergy 1 Business";
 
@@ -39,7 +43,34 @@ const auto kUrlContact = QString("%1/contact?%2").arg(kUrlWebsite, kUrlSourceQue
 
 const auto kUrlApiLicenseActivate = QString("%1/product/activate").arg(kUrlApi);
 const auto kUrlApiLicenseCheck = QString("%1/product/check").arg(kUrlApi);
+const auto kUrlApiLicenseHeartbeat = QString("%1/product/heartbeat").arg(kUrlApi);
 
 constexpr auto kLicenseGracePeriod = std::chrono::days{14};
+constexpr auto kLeaseRenewRetryInterval = std::chrono::hours{1};
+constexpr auto kLicenseApiRetryDelay = std::chrono::seconds{1};
+constexpr auto kLicenseApiMaxRetryDelay = std::chrono::minutes{1};
+constexpr auto kLicenseActivationRetryDelay = std::chrono::seconds{30};
+constexpr auto kLicenseActivationMaxRetryDelay = std::chrono::hours{1};
+constexpr auto kLicenseCheckInterval = std::chrono::days{1};
+constexpr auto kLicenseCheckStartupSpread = std::chrono::minutes{15};
+constexpr auto kLicenseCheckDeferInterval = std::chrono::hours{1};
+constexpr auto kLicenseCheckIdleThreshold = std::chrono::minutes{30};
+constexpr auto kSharedLicenseResultTtl = std::chrono::minutes{10};
+constexpr auto kLicenseLockStaleTime = std::chrono::minutes{2};
+constexpr auto kLicenseLockWait = std::chrono::seconds{30};
+constexpr auto kLicenseLockPollInterval = std::chrono::milliseconds{500};
+constexpr auto kLicenseStateLockWait = std::chrono::seconds{1};
+constexpr auto kLicenseRelayPort = 24803;
+constexpr auto kLicenseRelayBatchInterval = std::chrono::seconds{5};
+constexpr auto kLicenseRelaySuccessTtl = std::chrono::hours{1};
+constexpr auto kHttpReadTimeout = std::chrono::seconds{10};
+constexpr auto kSeatHeartbeatInterval = std::chrono::minutes{15};
+constexpr auto kMaxBufferedSeatHeartbeats = 2000;
+constexpr auto kSettingsSyncDelay = std::chrono::milliseconds{500};
+constexpr auto kStallWatchdogInterval = std::chrono::milliseconds{100};
+constexpr auto kStallThreshold = std::chrono::milliseconds{500};
+constexpr auto kMaxReportedStalls = 5;
+constexpr std::size_t kTraceBufferEvents = 1 << 16;
+constexpr auto kMetricsWriteInterval = std::chrono::seconds{15};
 
 } // namespace synergy::gui
@@ -0,0 +1,40 @@
+/*
+ * Synergy -- mouse and keyboard sharing utility
+ * Copyright (C) 2026 Symless Ltd.
+ *
+ * This package is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * found in the file LICENSE that should have accompanied this file.
+ *
+ * This package is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "ActivationTrace.h"
+
+namespace synergy::gui::license {
+
+QJsonObject ActivationTrace::toJson() const
+{
+  const auto us = [](microseconds value) { return static_cast<qint64>(value.count()); };
+
+  return {
+      {"settingsLoadUs", us(settingsLoad)},
+      {"fingerprintUs", us(fingerprint)},
+      {"queueUs", us(network.queue)},
+      {"lookupUs", us(network.lookup)},
+      {"connectUs", us(network.connect)},
+      {"serverUs", us(network.server)},
+      {"downloadUs", us(network.download)},
+      {"responseHandlingUs", us(responseHandling)},
+      {"coreStartUs", us(coreStart)},
+      {"totalUs", us(total)},
+  };
+}
+
+} // namespace synergy::gui::license
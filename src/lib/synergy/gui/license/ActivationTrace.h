@@ -0,0 +1,45 @@
+/*
+ * Synergy -- mouse and keyboard sharing utility
+ * Copyright (C) 2026 Symless Ltd.
+ *
+ * This package is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * found in the file LICENSE that should have accompanied this file.
+ *
+ * This package is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include "synergy/gui/license/LicenseApiClient.h"
+
+#include <QJsonObject>
+
+#include <chrono>
+
+namespace synergy::gui::license {
+
+/**
+ * @brief How long each phase took between clicking start and the core starting.
+ */
+struct ActivationTrace
+{
+  using microseconds = std::chrono::microseconds;
+
+  microseconds settingsLoad{0};
+  microseconds fingerprint{0};
+  LicenseApiClient::Result::Timings network;
+  microseconds responseHandling{0};
+  microseconds coreStart{0};
+  microseconds total{0};
+
+  QJsonObject toJson() const;
+};
+
+} // namespace synergy::gui::license
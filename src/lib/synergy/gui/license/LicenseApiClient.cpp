@@ -18,13 +18,21 @@
 #include "LicenseApiClient.h"
 
 #include "synergy/gui/constants.h"
+#include "synergy/gui/license/LicenseAuditLog.h"
+#include "synergy/gui/license/LicenseMetrics.h"
+#include "synergy/gui/license/license_wire.h"
+#include "synergy/gui/trace.h"
 
-#include <QJsonDocument>
-#include <QJsonObject>
+#include <QCborMap>
 #include <QNetworkReply>
+#include <QRandomGenerator>
 #include <QSysInfo>
 #include <QTimer>
 
+#include <algorithm>
+#include <chrono>
+#include <utility>
+
 namespace synergy::gui::license {
 
 QString activateUrl()
@@ -39,85 +47,260 @@ QString checkUrl()
   return envVar.isEmpty() ? kUrlApiLicenseCheck : envVar;
 }
 
-LicenseApiClient::LicenseApiClient()
+QString heartbeatUrl()
 {
-  connect(&m_manager, &QNetworkAccessManager::finished, this, &LicenseApiClient::handleResponse);
+  const auto envVar = qEnvironmentVariable("SYNERGY_TEST_API_URL_HEARTBEAT");
+  return envVar.isEmpty() ? kUrlApiLicenseHeartbeat : envVar;
 }
 
-void LicenseApiClient::activate(Data data)
+const char *LicenseApiClient::Result::statusName(Status status)
 {
-  post(RequestKind::kActivate, QUrl(activateUrl()), data);
+  switch (status) {
+    using enum Status;
+
+  case kSuccess:
+    return "success";
+  case kFailed:
+    return "failed";
+  case kNetworkError:
+    return "network_error";
+  case kDisabled:
+    return "disabled";
+  case kCanceled:
+    return "canceled";
+  }
+
+  return "unknown";
 }
 
-void LicenseApiClient::check(Data data)
+QFuture<LicenseApiClient::Result> LicenseApiClient::activate(Data data)
 {
-  post(RequestKind::kCheck, QUrl(checkUrl()), data);
+  return queuePost(RequestKind::kActivate, QUrl(activateUrl()), data);
 }
 
-void LicenseApiClient::post(RequestKind kind, const QUrl &url, const Data &data)
+QFuture<LicenseApiClient::Result> LicenseApiClient::check(Data data)
 {
-  m_isBusy = true;
-  m_pendingKind = kind;
+  return check(std::move(data), QUrl(checkUrl()));
+}
 
-  qDebug().noquote() << "license api request:" << url.toString();
+QFuture<LicenseApiClient::Result> LicenseApiClient::check(Data data, const QUrl &url)
+{
+  return queuePost(RequestKind::kCheck, url, data);
+}
 
-  auto request = QNetworkRequest(url);
-  request.setHeader(QNetworkRequest::ContentTypeHeader, "application/json");
+QFuture<LicenseApiClient::Result> LicenseApiClient::heartbeat(Data data, QCborArray heartbeats)
+{
+  QCborMap extra;
+  extra[QStringLiteral("heartbeats")] = heartbeats;
+  return queuePost(RequestKind::kHeartbeat, QUrl(heartbeatUrl()), data, extra);
+}
 
-  m_manager.post(request, getRequestData(data));
+std::chrono::milliseconds LicenseApiClient::retryDelay(
+    int failures, std::chrono::milliseconds first, std::chrono::milliseconds max, QRandomGenerator &random
+)
+{
+  // Capped shift, so many failures in a row can't overflow.
+  const auto doublings = std::clamp(failures - 1, 0, 20);
+  const auto backoff = std::min<qint64>(first.count() << doublings, max.count());
+  return std::chrono::milliseconds{random.bounded(static_cast<quint64>(std::max<qint64>(backoff, 0)) + 1)};
 }
 
-void LicenseApiClient::handleResponse(QNetworkReply *reply)
+void LicenseApiClient::cancelAll()
 {
-  m_isBusy = false;
-  const auto kind = m_pendingKind;
+  QMetaObject::invokeMethod(
+      this,
+      [this] {
+        // Aborting emits `finished` for each reply, which completes its future as canceled.
+        const auto replies = m_pending.keys();
+        for (auto reply : replies) {
+          reply->abort();
+        }
+      },
+      Qt::QueuedConnection
+  );
+}
 
-  const auto emitFailed = [this, kind](const QString &message) {
-    if (kind == RequestKind::kActivate) {
-      Q_EMIT activationFailed(message);
-    } else {
-      Q_EMIT checkFailed(message);
-    }
-  };
+QFuture<LicenseApiClient::Result>
+LicenseApiClient::queuePost(RequestKind kind, const QUrl &url, const Data &data, const QCborMap &extra)
+{
+  // Count on the calling thread so that a second call straight after this one sees
+  // it, rather than racing with the worker thread picking up the request.
+  m_pendingCount++;
+
+  // Shared, since the promise is move-only and the queued lambda must be copyable.
+  auto promise = std::make_shared<QPromise<Result>>();
+  promise->start();
+  auto future = promise->future();
+
+  QElapsedTimer timer;
+  timer.start();
+
+  // Callers are usually on the GUI thread, so hop over to the thread this object lives
+  // on; the network manager, the reply and the response parsing all stay on that thread.
+  QMetaObject::invokeMethod(
+      this, [this, kind, url, data, extra, promise, timer] { post(kind, url, data, extra, promise, timer); },
+      Qt::QueuedConnection
+  );
+
+  return future;
+}
 
-  const auto emitSucceeded = [this, kind] {
-    if (kind == RequestKind::kActivate) {
-      Q_EMIT activationSucceeded();
-    } else {
-      Q_EMIT checkSucceeded();
+void LicenseApiClient::post(
+    RequestKind kind, const QUrl &url, const Data &data, const QCborMap &extra,
+    std::shared_ptr<QPromise<Result>> promise, QElapsedTimer timer
+)
+{
+  if (m_manager == nullptr) {
+    // Created lazily so that the manager belongs to the worker thread, not the thread
+    // that constructed the client.
+    m_manager = new QNetworkAccessManager(this);
+    connect(m_manager, &QNetworkAccessManager::finished, this, &LicenseApiClient::handleResponse);
+  }
+
+  qDebug().noquote() << "license api request:" << url.toString();
+
+  const auto format = requestWireFormat();
+  auto request = QNetworkRequest(url);
+  request.setHeader(QNetworkRequest::ContentTypeHeader, contentType(format));
+  request.setRawHeader("Accept", acceptHeader(format));
+
+  const auto reply = m_manager->post(request, getRequestData(data, extra, format));
+  m_pending.insert(reply, {kind, std::move(promise), timer, timer.nsecsElapsed()});
+
+  // Mark each phase of the request, so slow activations can be broken down.
+  connect(reply, &QNetworkReply::socketStartedConnecting, this, [this, reply] {
+    if (auto it = m_pending.find(reply); it != m_pending.end()) {
+      it->connectingNs = it->timer.nsecsElapsed();
     }
-  };
+  });
+  connect(reply, &QNetworkReply::requestSent, this, [this, reply] {
+    if (auto it = m_pending.find(reply); it != m_pending.end()) {
+      it->sentNs = it->timer.nsecsElapsed();
+    }
+  });
+  connect(reply, &QNetworkReply::metaDataChanged, this, [this, reply] {
+    if (auto it = m_pending.find(reply); it != m_pending.end() && it->headersNs == 0) {
+      it->headersNs = it->timer.nsecsElapsed();
+    }
+  });
+}
 
+void LicenseApiClient::handleResponse(QNetworkReply *reply)
+{
   if (!reply) {
     qWarning("no license api reply");
-    emitFailed("License request failed, empty network reply.");
     return;
   }
 
+  const auto pending = m_pending.take(reply);
+  if (!pending.promise) {
+    qWarning("license api reply was not pending");
+    reply->deleteLater();
+    return;
+  }
+
+  auto result = readReply(reply);
+  result.timings = timings(pending);
+  reply->deleteLater();
+
+  const auto kindName = pending.kind == RequestKind::kActivate ? "activate"
+                        : pending.kind == RequestKind::kCheck  ? "check"
+                                                               : "heartbeat";
+  qDebug("license api %s request finished, status: %d", kindName, static_cast<int>(result.status));
+
+  const auto endpoint = pending.kind == RequestKind::kActivate ? LicenseMetrics::Endpoint::kActivate
+                        : pending.kind == RequestKind::kCheck  ? LicenseMetrics::Endpoint::kCheck
+                                                               : LicenseMetrics::Endpoint::kHeartbeat;
+  const auto latency = std::chrono::microseconds{pending.timer.nsecsElapsed() / 1000};
+  LicenseMetrics::instance().recordApiRequest(endpoint, result.status, latency);
+  LicenseAuditLog::instance().append(
+      LicenseAuditLog::resultEvent(LicenseAuditLog::Type::kApiRequest, result.status, latency, kindName)
+  );
+
+  if (trace::isEnabled()) {
+    traceRequest(pending, result.timings);
+  }
+
+  m_pendingCount--;
+  pending.promise->addResult(result);
+  pending.promise->finish();
+}
+
+void LicenseApiClient::traceRequest(const Pending &pending, const Result::Timings &timings)
+{
+  const auto spanName = pending.kind == RequestKind::kActivate ? "LicenseApiClient::activate"
+                        : pending.kind == RequestKind::kCheck  ? "LicenseApiClient::check"
+                                                               : "LicenseApiClient::heartbeat";
+
+  // The request is over, so lay its phases end to end back from now.
+  const auto endUs = trace::nowMicros();
+  auto startUs = endUs - pending.timer.nsecsElapsed() / 1000;
+  trace::complete(spanName, startUs, endUs - startUs);
+
+  const std::pair<const char *, std::chrono::microseconds> phases[] = {
+      {"license api queue", timings.queue},     {"license api lookup", timings.lookup},
+      {"license api connect", timings.connect}, {"license api server", timings.server},
+      {"license api download", timings.download},
+  };
+  for (const auto &[name, duration] : phases) {
+    trace::complete(name, startUs, duration.count());
+    startUs += duration.count();
+  }
+}
+
+LicenseApiClient::Result::Timings LicenseApiClient::timings(const Pending &pending)
+{
+  using namespace std::chrono;
+
+  const auto doneNs = pending.timer.nsecsElapsed();
+  const auto toMicros = [](qint64 ns) { return duration_cast<microseconds>(nanoseconds{std::max<qint64>(0, ns)}); };
+
+  // Steps that didn't happen (e.g. connecting, on a reused connection) take no time,
+  // and the next step is measured from the one before.
+  const auto connectStartNs = pending.connectingNs > 0 ? pending.connectingNs : pending.postedNs;
+  const auto sentNs = pending.sentNs > 0 ? pending.sentNs : connectStartNs;
+  const auto headersNs = pending.headersNs > 0 ? pending.headersNs : doneNs;
+
+  Result::Timings timings;
+  timings.queue = toMicros(pending.postedNs);
+  timings.lookup = toMicros(connectStartNs - pending.postedNs);
+  timings.connect = toMicros(sentNs - connectStartNs);
+  timings.server = toMicros(headersNs - sentNs);
+  timings.download = toMicros(doneNs - headersNs);
+  return timings;
+}
+
+LicenseApiClient::Result LicenseApiClient::readReply(QNetworkReply *reply) const
+{
+  using enum Result::Status;
+
   const auto response = reply->readAll();
 
+  if (reply->error() == QNetworkReply::OperationCanceledError) {
+    qDebug("license api request canceled");
+    return {kCanceled, {}};
+  }
+
   if (reply->error() != QNetworkReply::NoError) {
     const auto kLimit = 200;
     const auto responseSliced = response.length() > kLimit ? response.sliced(0, kLimit) + "..." : response;
     qWarning().noquote() << "license api error:" << reply->error() << reply->errorString() << responseSliced;
-    emitFailed("License request failed, there was a network error.");
-    reply->deleteLater();
-    return;
+    return {kNetworkError, "License request failed, there was a network error."};
   }
 
-  qDebug().noquote() << "license api response:" << response;
-  const auto jsonDoc = QJsonDocument::fromJson(response);
-  if (response.isNull()) {
-    qWarning("empty license api response");
-    emitFailed("License request failed, the server sent an empty response.");
-    reply->deleteLater();
-    return;
+  const auto responseType = reply->header(QNetworkRequest::ContentTypeHeader).toString();
+  qDebug().noquote() << "license api response:" << responseType << response.size() << "bytes";
+
+  bool decoded = false;
+  const auto body = decodeMessage(response, responseWireFormat(responseType), &decoded);
+  if (!decoded) {
+    qWarning("empty or invalid license api response");
+    return {kFailed, "License request failed, the server sent an empty response."};
   }
 
-  const auto json = jsonDoc.object();
-  if (json["status"].toString() != "success") {
-    const auto status = json["status"].toString();
-    const auto message = json["message"].toString();
+  const auto status = body.value(QStringLiteral("status")).toString();
+  if (status != "success") {
+    const auto message = body.value(QStringLiteral("message")).toString();
 
     if (!status.isEmpty()) {
       qWarning().noquote() << "license api status:" << status;
@@ -132,23 +315,19 @@ void LicenseApiClient::handleResponse(QNetworkReply *reply)
     }
 
     if (status == "disabled") {
-      Q_EMIT licenseDisabled(message.isEmpty() ? QStringLiteral("License has been disabled.") : message);
+      return {kDisabled, message.isEmpty() ? QStringLiteral("License has been disabled.") : message};
     } else if (!message.isEmpty()) {
-      emitFailed(message);
+      return {kFailed, message};
     } else {
-      emitFailed("License request failed, unknown error.");
+      return {kFailed, "License request failed, unknown error."};
     }
-
-    reply->deleteLater();
-    return;
   }
 
   qInfo().noquote() << "license api request successful";
-  emitSucceeded();
-  reply->deleteLater();
+  return {kSuccess, {}, body.value(QStringLiteral("lease")).toString()};
 }
 
-QByteArray LicenseApiClient::getRequestData(const Data &data) const
+QByteArray LicenseApiClient::getRequestData(const Data &data, const QCborMap &extra, WireFormat format) const
 {
   if (data.machineSignature.isEmpty()) {
     qFatal("cannot create license request, no machine id");
@@ -170,15 +349,15 @@ QByteArray LicenseApiClient::getRequestData(const Data &data) const
     qFatal("cannot create license request, no os name");
   }
 
-  QJsonObject requestData;
-  requestData["machineSignature"] = data.machineSignature;
-  requestData["hostnameSignature"] = data.hostnameSignature;
-  requestData["serialKey"] = data.serialKey;
-  requestData["appVersion"] = data.appVersion;
-  requestData["osName"] = data.osName;
-  requestData["isServer"] = data.isServer;
+  QCborMap requestData = extra;
+  requestData[QStringLiteral("machineSignature")] = data.machineSignature;
+  requestData[QStringLiteral("hostnameSignature")] = data.hostnameSignature;
+  requestData[QStringLiteral("serialKey")] = data.serialKey;
+  requestData[QStringLiteral("appVersion")] = data.appVersion;
+  requestData[QStringLiteral("osName")] = data.osName;
+  requestData[QStringLiteral("isServer")] = data.isServer;
 
-  return QJsonDocument(requestData).toJson();
+  return encodeMessage(requestData, format);
 }
 
 }; // namespace synergy::gui::license
@@ -17,14 +17,35 @@
 
 #pragma once
 
+#include "synergy/gui/license/license_wire.h"
+
+#include <QCborArray>
+#include <QCborMap>
+#include <QElapsedTimer>
+#include <QFuture>
+#include <QHash>
 #include <QNetworkAccessManager>
 #include <QObject>
+#include <QPromise>
 #include <QTimer>
 
+#include <atomic>
+#include <chrono>
+#include <memory>
+
 class QNetworkReply;
+class QRandomGenerator;
 
 namespace synergy::gui::license {
 
+/**
+ * @brief Talks to the license API.
+ *
+ * Intended to live on a worker thread (see `QObject::moveToThread`). The request
+ * functions may be called from any thread and return a future which is completed on
+ * the worker thread; use `QFuture::then` with a context object to handle the result
+ * on that object's thread. Several requests may be in flight at once.
+ */
 class LicenseApiClient : public QObject
 {
   Q_OBJECT
@@ -40,22 +61,86 @@ public:
     bool isServer;
   };
 
-  explicit LicenseApiClient();
+  struct Result
+  {
+    enum class Status
+    {
+      kSuccess,
+      kFailed,
+      kNetworkError,
+      kDisabled,
+      kCanceled
+    };
+
+    /**
+     * @brief Where the time went, as seen from the worker thread.
+     *
+     * Lookup and connect are zero when an existing connection was reused.
+     */
+    struct Timings
+    {
+      std::chrono::microseconds queue{0};
+      std::chrono::microseconds lookup{0};
+      std::chrono::microseconds connect{0};
+      std::chrono::microseconds server{0};
+      std::chrono::microseconds download{0};
+
+      std::chrono::microseconds total() const
+      {
+        return queue + lookup + connect + server + download;
+      }
+    };
+
+    Status status = Status::kFailed;
+    QString message;
+    QString lease;
+    Timings timings;
 
-  void activate(Data data);
-  void check(Data data);
+    bool isSuccess() const
+    {
+      return status == Status::kSuccess;
+    }
+
+    /**
+     * @brief A name for the status that suits logs and metric labels, e.g. `network_error`.
+     */
+    static const char *statusName(Status status);
+  };
 
-  bool isBusy()
+  explicit LicenseApiClient() = default;
+
+  QFuture<Result> activate(Data data);
+  QFuture<Result> check(Data data);
+
+  /**
+   * @brief Sends the check to another URL, e.g. a license relay on the LAN.
+   */
+  QFuture<Result> check(Data data, const QUrl &url);
+
+  /**
+   * @brief Reports seat usage; several heartbeats may be sent in one request.
+   */
+  QFuture<Result> heartbeat(Data data, QCborArray heartbeats);
+
+  /**
+   * @brief Aborts all in-flight requests, their futures complete as `kCanceled`.
+   */
+  void cancelAll();
+
+  bool isBusy() const
   {
-    return m_isBusy;
+    return m_pendingCount > 0;
   }
 
-signals:
-  void activationFailed(const QString &message);
-  void activationSucceeded();
-  void checkFailed(const QString &message);
-  void checkSucceeded();
-  void licenseDisabled(const QString &message);
+  /**
+   * @brief How long to wait before retrying after `failures` network errors in a row.
+   *
+   * Exponential backoff from `first` up to `max`, with full jitter, so clients that lost
+   * the license API together don't all come back at the same moment.
+   */
+  static std::chrono::milliseconds retryDelay(
+      int failures, std::chrono::milliseconds first, std::chrono::milliseconds max, QRandomGenerator &random
+  );
 
 private slots:
   void handleResponse(QNetworkReply *reply);
@@ -64,15 +149,36 @@ private:
   enum class RequestKind
   {
     kActivate,
-    kCheck
+    kCheck,
+    kHeartbeat
+  };
+
+  struct Pending
+  {
+    RequestKind kind = RequestKind::kActivate;
+    std::shared_ptr<QPromise<Result>> promise;
+
+    // Nanoseconds since the request was queued; zero if the step didn't happen.
+    QElapsedTimer timer;
+    qint64 postedNs = 0;
+    qint64 connectingNs = 0;
+    qint64 sentNs = 0;
+    qint64 headersNs = 0;
   };
 
-  void post(RequestKind kind, const QUrl &url, const Data &data);
-  QByteArray getRequestData(const Data &data) const;
+  QFuture<Result> queuePost(RequestKind kind, const QUrl &url, const Data &data, const QCborMap &extra = {});
+  void post(
+      RequestKind kind, const QUrl &url, const Data &data, const QCborMap &extra,
+      std::shared_ptr<QPromise<Result>> promise, QElapsedTimer timer
+  );
+  static Result::Timings timings(const Pending &pending);
+  static void traceRequest(const Pending &pending, const Result::Timings &timings);
+  Result readReply(QNetworkReply *reply) const;
+  QByteArray getRequestData(const Data &data, const QCborMap &extra, WireFormat format) const;
 
-  QNetworkAccessManager m_manager;
-  bool m_isBusy = false;
-  RequestKind m_pendingKind = RequestKind::kActivate;
+  QNetworkAccessManager *m_manager = nullptr;
+  QHash<QNetworkReply *, Pending> m_pending;
+  std::atomic_int m_pendingCount = 0;
 };
 
 } // namespace synergy::gui::license
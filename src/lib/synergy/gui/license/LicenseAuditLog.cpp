@@ -0,0 +1,334 @@
+/*
+ * Synergy -- mouse and keyboard sharing utility
+ * Copyright (C) 2026 Symless Ltd.
+ *
+ * This package is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * found in the file LICENSE that should have accompanied this file.
+ *
+ * This package is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "LicenseAuditLog.h"
+
+#include "synergy/gui/constants.h"
+
+#include <QDateTime>
+#include <QDir>
+#include <QFileInfo>
+#include <QScopeGuard>
+#include <QStandardPaths>
+#include <QtCore>
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstring>
+
+using namespace std::chrono;
+
+namespace synergy::gui::license {
+
+namespace {
+
+const quint32 kMagic = 0x414c5953; // "SYLA"
+const quint16 kVersion = 1;
+
+struct Header
+{
+  quint32 magic;
+  quint16 version;
+  quint16 recordSize;
+  quint32 capacity;
+  quint32 reserved0;
+
+  // Sequence number of the next record, shared by every writer; one-based.
+  quint64 next;
+  quint8 reserved[40];
+};
+
+using Record = LicenseAuditLog::Record;
+
+static_assert(sizeof(Header) == 64);
+static_assert(sizeof(Record) == 64);
+static_assert(std::atomic_ref<quint64>::is_always_lock_free);
+
+const std::array kTypeNames = {
+    "serial_key_changed", "activation_result", "check_result",  "api_request",
+    "grace_started",      "grace_cleared",     "remote_disable", "feature_clamped",
+};
+
+qint64 fileSize(quint32 capacity)
+{
+  return static_cast<qint64>(sizeof(Header)) + static_cast<qint64>(capacity) * static_cast<qint64>(sizeof(Record));
+}
+
+bool isValid(const Header &header)
+{
+  return header.magic == kMagic && header.version == kVersion && header.recordSize == sizeof(Record) &&
+         header.capacity > 0;
+}
+
+bool hasStatus(quint16 type)
+{
+  using enum LicenseAuditLog::Type;
+  const auto value = static_cast<LicenseAuditLog::Type>(type);
+  return value == kActivationResult || value == kCheckResult || value == kApiRequest;
+}
+
+QString timeString(const Record &record)
+{
+  return QDateTime::fromMSecsSinceEpoch(record.timeMsecs).toUTC().toString(Qt::ISODateWithMs);
+}
+
+QString detailString(const Record &record)
+{
+  return QString::fromUtf8(record.detail, qstrnlen(record.detail, sizeof(record.detail)));
+}
+
+// Cutting inside a multi-byte character would leave an invalid sequence at the end.
+qsizetype utf8PrefixSize(QByteArrayView text, qsizetype maxSize)
+{
+  if (text.size() <= maxSize) {
+    return text.size();
+  }
+
+  auto size = maxSize;
+  while (size > 0 && (static_cast<uchar>(text[size]) & 0xc0) == 0x80) {
+    size--;
+  }
+  return size;
+}
+
+// Copies a slot like a seqlock reader: the sequence is read before and after, and
+// the copy only counts if it didn't change in between (zero means mid-write).
+std::optional<Record> readRecord(const uchar *data, quint32 index)
+{
+  auto &slot = *reinterpret_cast<Record *>(const_cast<uchar *>(data) + sizeof(Header) + index * sizeof(Record));
+
+  const auto before = std::atomic_ref(slot.sequence).load(std::memory_order_acquire);
+  if (before == 0) {
+    return std::nullopt;
+  }
+
+  Record record;
+  std::memcpy(&record, &slot, sizeof(record));
+  std::atomic_thread_fence(std::memory_order_acquire);
+
+  const auto after = std::atomic_ref(slot.sequence).load(std::memory_order_relaxed);
+  if (after != before) {
+    return std::nullopt;
+  }
+
+  record.sequence = before;
+  return record;
+}
+
+} // namespace
+
+LicenseAuditLog &LicenseAuditLog::instance()
+{
+  static LicenseAuditLog log(defaultPath());
+  static const auto opened = log.open();
+  Q_UNUSED(opened)
+  return log;
+}
+
+QString LicenseAuditLog::defaultPath()
+{
+  const auto dir = QStandardPaths::writableLocation(QStandardPaths::AppLocalDataLocation);
+  return QDir(dir).filePath("license-audit.bin");
+}
+
+LicenseAuditLog::LicenseAuditLog(const QString &path, quint32 capacity)
+    : m_file(path),
+      m_lock(path + ".lock"),
+      m_capacity(capacity)
+{
+  m_lock.setStaleLockTime(duration_cast<milliseconds>(kLicenseLockStaleTime));
+}
+
+LicenseAuditLog::~LicenseAuditLog()
+{
+  if (m_data != nullptr) {
+    m_file.unmap(m_data);
+  }
+}
+
+bool LicenseAuditLog::open()
+{
+  if (m_data != nullptr) {
+    return true;
+  }
+
+  QDir().mkpath(QFileInfo(m_file.fileName()).absolutePath());
+
+  // Otherwise another process could start the file again while this one maps it.
+  if (!m_lock.tryLock(duration_cast<milliseconds>(kLicenseStateLockWait))) {
+    qWarning().noquote() << "unable to lock license audit log, error:" << static_cast<int>(m_lock.error())
+                         << m_file.fileName();
+    return false;
+  }
+  const auto unlock = qScopeGuard([this] { m_lock.unlock(); });
+
+  if (!m_file.open(QIODevice::ReadWrite)) {
+    qWarning().noquote() << "unable to open license audit log:" << m_file.fileName() << m_file.errorString();
+    return false;
+  }
+
+  Header header{};
+  m_file.read(reinterpret_cast<char *>(&header), sizeof(header));
+  if (!isValid(header) || header.capacity != m_capacity || m_file.size() != fileSize(m_capacity)) {
+    if (m_file.size() > 0) {
+      qWarning().noquote() << "license audit log not valid or resized, starting again:" << m_file.fileName();
+    }
+
+    header = {kMagic, kVersion, static_cast<quint16>(sizeof(Record)), m_capacity, 0, 1, {}};
+    if (!m_file.resize(0) || !m_file.resize(fileSize(m_capacity)) || !m_file.seek(0) ||
+        m_file.write(reinterpret_cast<const char *>(&header), sizeof(header)) != sizeof(header) || !m_file.flush()) {
+      qWarning().noquote() << "unable to create license audit log:" << m_file.fileName() << m_file.errorString();
+      m_file.close();
+      return false;
+    }
+  }
+
+  m_data = m_file.map(0, fileSize(m_capacity));
+  if (m_data == nullptr) {
+    qWarning().noquote() << "unable to map license audit log:" << m_file.fileName() << m_file.errorString();
+    m_file.close();
+    return false;
+  }
+
+  return true;
+}
+
+void LicenseAuditLog::append(const Event &event)
+{
+  if (m_data == nullptr) {
+    return;
+  }
+
+  auto &header = *reinterpret_cast<Header *>(m_data);
+  const auto sequence = std::atomic_ref(header.next).fetch_add(1, std::memory_order_relaxed);
+  auto &record = reinterpret_cast<Record *>(m_data + sizeof(Header))[(sequence - 1) % m_capacity];
+
+  // Mark the slot empty while it's filled in, so a reader never pairs the old sequence
+  // number with a half-written event.
+  std::atomic_ref(record.sequence).store(0, std::memory_order_relaxed);
+  std::atomic_thread_fence(std::memory_order_release);
+
+  record.timeMsecs = duration_cast<milliseconds>(system_clock::now().time_since_epoch()).count();
+  record.type = static_cast<quint16>(event.type);
+  record.status = event.status;
+  record.latencyMs = event.latencyMs;
+  record.value = event.value;
+  const auto detailSize = utf8PrefixSize(event.detail, sizeof(record.detail) - 1);
+  std::memcpy(record.detail, event.detail.data(), detailSize);
+  std::memset(record.detail + detailSize, 0, sizeof(record.detail) - detailSize);
+
+  std::atomic_ref(record.sequence).store(sequence, std::memory_order_release);
+}
+
+LicenseAuditLog::Event LicenseAuditLog::resultEvent(
+    Type type, LicenseApiClient::Result::Status status, microseconds latency, QByteArrayView detail
+)
+{
+  const auto latencyMs = std::clamp<qint64>(duration_cast<milliseconds>(latency).count(), 0, UINT32_MAX);
+  return {type, static_cast<quint16>(status), static_cast<quint32>(latencyMs), 0, detail};
+}
+
+std::optional<std::vector<Record>> LicenseAuditLog::readFile(const QString &path)
+{
+  QFile file(path);
+  if (!file.open(QIODevice::ReadOnly)) {
+    qWarning().noquote() << "unable to open license audit log:" << path << file.errorString();
+    return std::nullopt;
+  }
+
+  Header header{};
+  if (file.size() < static_cast<qint64>(sizeof(header)) ||
+      file.read(reinterpret_cast<char *>(&header), sizeof(header)) != sizeof(header)) {
+    return std::nullopt;
+  }
+  if (!isValid(header) || file.size() != fileSize(header.capacity)) {
+    return std::nullopt;
+  }
+
+  // Mapped rather than read, so each record can be checked against the running app's writes.
+  const auto *data = file.map(0, file.size());
+  if (data == nullptr) {
+    qWarning().noquote() << "unable to map license audit log:" << path << file.errorString();
+    return std::nullopt;
+  }
+  const auto unmap = qScopeGuard([&file, data] { file.unmap(const_cast<uchar *>(data)); });
+
+  std::vector<Record> records;
+  records.reserve(header.capacity);
+  for (quint32 i = 0; i < header.capacity; i++) {
+    // A slot whose sequence doesn't belong there was being written while it was copied.
+    const auto record = readRecord(data, i);
+    if (record.has_value() && (record->sequence - 1) % header.capacity == i) {
+      records.push_back(*record);
+    }
+  }
+
+  std::sort(records.begin(), records.end(), [](const Record &a, const Record &b) { return a.sequence < b.sequence; });
+  return records;
+}
+
+const char *LicenseAuditLog::typeName(quint16 type)
+{
+  if (type == 0 || type > kTypeNames.size()) {
+    return "unknown";
+  }
+  return kTypeNames[type - 1];
+}
+
+QJsonObject LicenseAuditLog::toJson(const Record &record)
+{
+  QJsonObject json{
+      {"sequence", static_cast<qint64>(record.sequence)},
+      {"time", timeString(record)},
+      {"type", typeName(record.type)},
+  };
+
+  if (hasStatus(record.type)) {
+    const auto status = static_cast<LicenseApiClient::Result::Status>(record.status);
+    json["status"] = LicenseApiClient::Result::statusName(status);
+    json["latencyMs"] = static_cast<qint64>(record.latencyMs);
+  }
+  if (record.value != 0) {
+    json["value"] = record.value;
+  }
+  if (const auto detail = detailString(record); !detail.isEmpty()) {
+    json["detail"] = detail;
+  }
+  return json;
+}
+
+QString LicenseAuditLog::toText(const Record &record)
+{
+  auto text = QString("%1 %2").arg(timeString(record), QLatin1StringView(typeName(record.type)));
+
+  if (hasStatus(record.type)) {
+    const auto status = static_cast<LicenseApiClient::Result::Status>(record.status);
+    text += QString(" status=%1 latency=%2ms")
+                .arg(QLatin1StringView(LicenseApiClient::Result::statusName(status)))
+                .arg(record.latencyMs);
+  }
+  if (record.value != 0) {
+    text += QString(" value=%1").arg(record.value);
+  }
+  if (const auto detail = detailString(record); !detail.isEmpty()) {
+    text += QString(" detail=\"%1\"").arg(detail);
+  }
+  return text;
+}
+
+} // namespace synergy::gui::license
@@ -0,0 +1,128 @@
+/*
+ * Synergy -- mouse and keyboard sharing utility
+ * Copyright (C) 2026 Symless Ltd.
+ *
+ * This package is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * found in the file LICENSE that should have accompanied this file.
+ *
+ * This package is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include "synergy/gui/license/LicenseApiClient.h"
+
+#include <QByteArrayView>
+#include <QFile>
+#include <QJsonObject>
+#include <QLockFile>
+#include <QString>
+
+#include <chrono>
+#include <optional>
+#include <vector>
+
+namespace synergy::gui::license {
+
+/**
+ * @brief A record of license events that survives log rotation, for support cases like
+ * "it stopped working last Tuesday".
+ *
+ * Events are fixed-size binary records in a memory-mapped ring buffer, so the file never
+ * grows past its capacity and the oldest events are overwritten first. Appending takes
+ * a slot with one atomic increment and fills it in place, so it's safe from any thread
+ * and costs about as much as reading the clock. `synergy-license-audit` decodes the
+ * file to text or JSON.
+ */
+class LicenseAuditLog
+{
+public:
+  static constexpr quint32 kDefaultCapacity = 4096;
+  static constexpr quint16 kNoStatus = 0xffff;
+
+  enum class Type : quint16
+  {
+    kSerialKeyChanged = 1,
+    kActivationResult,
+    kCheckResult,
+    kApiRequest,
+    kGraceStarted,
+    kGraceCleared,
+    kRemoteDisable,
+    kFeatureClamped
+  };
+
+  /**
+   * @brief As stored in the file, in the machine's byte order.
+   */
+  struct Record
+  {
+    // One-based, so zero means the slot is empty; written last.
+    quint64 sequence;
+    qint64 timeMsecs;
+    quint16 type;
+    quint16 status;
+    quint32 latencyMs;
+    qint64 value;
+    char detail[32];
+  };
+
+  struct Event
+  {
+    Type type;
+    quint16 status = kNoStatus;
+    quint32 latencyMs = 0;
+    qint64 value = 0;
+
+    // Truncated to fit at a UTF-8 character boundary, e.g. an endpoint or the start
+    // of a server message.
+    QByteArrayView detail;
+  };
+
+  /**
+   * @brief The log for this app, opened on first use.
+   */
+  static LicenseAuditLog &instance();
+  static QString defaultPath();
+
+  explicit LicenseAuditLog(const QString &path, quint32 capacity = kDefaultCapacity);
+  ~LicenseAuditLog();
+
+  LicenseAuditLog(const LicenseAuditLog &) = delete;
+  LicenseAuditLog &operator=(const LicenseAuditLog &) = delete;
+
+  bool open();
+  void append(const Event &event);
+
+  static Event resultEvent(
+      Type type, LicenseApiClient::Result::Status status, std::chrono::microseconds latency, QByteArrayView detail = {}
+  );
+
+  /**
+   * @brief Reads a log file (e.g. one sent in by a customer), oldest record first.
+   *
+   * Safe while the app is appending; a record that changes while it's copied is left out.
+   *
+   * @return Nothing if the file isn't a license audit log.
+   */
+  static std::optional<std::vector<Record>> readFile(const QString &path);
+
+  static const char *typeName(quint16 type);
+  static QJsonObject toJson(const Record &record);
+  static QString toText(const Record &record);
+
+private:
+  QFile m_file;
+  QLockFile m_lock;
+  quint32 m_capacity;
+  uchar *m_data = nullptr;
+};
+
+} // namespace synergy::gui::license
@@ -0,0 +1,134 @@
+/*
+ * Synergy -- mouse and keyboard sharing utility
+ * Copyright (C) 2026 Symless Ltd.
+ *
+ * This package is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * found in the file LICENSE that should have accompanied this file.
+ *
+ * This package is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "LicenseCheckScheduler.h"
+
+#include "synergy/gui/constants.h"
+#include "synergy/gui/power_utils.h"
+
+#include <QDateTime>
+#include <QRandomGenerator>
+#include <QtCore>
+
+#include <algorithm>
+#include <climits>
+
+using namespace std::chrono;
+
+namespace synergy::gui::license {
+
+LicenseCheckScheduler::LicenseCheckScheduler(QObject *parent) : QObject(parent)
+{
+  m_timer.setSingleShot(true);
+  connect(&m_timer, &QTimer::timeout, this, &LicenseCheckScheduler::handleTimeout);
+}
+
+void LicenseCheckScheduler::start(const QString &machineSignature, seconds period, qint64 lastCheckSecs)
+{
+  if (period.count() <= 0) {
+    qWarning("invalid license check period, not scheduling checks");
+    return;
+  }
+
+  m_period = period;
+  m_offset = stableOffset(machineSignature, period);
+
+  const auto now = QDateTime::currentSecsSinceEpoch();
+  const auto dueSecs = firstDueSecs(now, lastCheckSecs, m_offset, m_period, *QRandomGenerator::global());
+  qDebug("first license check in %lld seconds", static_cast<long long>(dueSecs - now));
+  scheduleAt(dueSecs);
+}
+
+void LicenseCheckScheduler::stop()
+{
+  m_timer.stop();
+}
+
+seconds LicenseCheckScheduler::stableOffset(const QString &machineSignature, seconds period)
+{
+  // The signature is a hex hash, so any prefix of it is evenly distributed.
+  bool ok = false;
+  const auto kHexDigits = 15;
+  const auto value = machineSignature.left(kHexDigits).toULongLong(&ok, 16);
+  if (!ok || period.count() <= 0) {
+    return seconds{0};
+  }
+
+  return seconds{static_cast<seconds::rep>(value % static_cast<quint64>(period.count()))};
+}
+
+qint64 LicenseCheckScheduler::nextSlotSecs(qint64 nowSecs, seconds offset, seconds period)
+{
+  const auto p = period.count();
+  const auto phase = (((nowSecs - offset.count()) % p) + p) % p;
+  return nowSecs + (p - phase);
+}
+
+qint64 LicenseCheckScheduler::firstDueSecs(
+    qint64 nowSecs, qint64 lastCheckSecs, seconds offset, seconds period, QRandomGenerator &random
+)
+{
+  if (nowSecs - lastCheckSecs < period.count()) {
+    return nextSlotSecs(nowSecs, offset, period);
+  }
+
+  // Overdue, so check soon, but not at the exact moment the machine booted.
+  const auto spread = duration_cast<seconds>(kLicenseCheckStartupSpread).count();
+  return nowSecs + random.bounded(static_cast<int>(spread));
+}
+
+milliseconds LicenseCheckScheduler::jitter(seconds period, QRandomGenerator &random)
+{
+  const auto maxJitter = std::clamp<qint64>(duration_cast<milliseconds>(period).count() / 20, 1, INT_MAX);
+  return milliseconds{random.bounded(static_cast<int>(maxJitter))};
+}
+
+void LicenseCheckScheduler::scheduleAt(qint64 dueSecs)
+{
+  m_dueSecs = dueSecs;
+
+  const auto now = QDateTime::currentSecsSinceEpoch();
+  const auto delay = std::max<qint64>(0, dueSecs - now) * 1000 + jitter(m_period, *QRandomGenerator::global()).count();
+
+  // Long periods may not fit in the timer, in which case it fires early and reschedules.
+  m_timer.start(static_cast<int>(std::min<qint64>(delay, INT_MAX)));
+}
+
+void LicenseCheckScheduler::handleTimeout()
+{
+  const auto now = QDateTime::currentSecsSinceEpoch();
+  if (now < m_dueSecs) {
+    scheduleAt(m_dueSecs);
+    return;
+  }
+
+  if (shouldDefer()) {
+    qDebug("deferring license check, machine is idle or on battery");
+    scheduleAt(now + duration_cast<seconds>(kLicenseCheckDeferInterval).count());
+    return;
+  }
+
+  scheduleAt(nextSlotSecs(now, m_offset, m_period));
+  Q_EMIT checkDue();
+}
+
+bool LicenseCheckScheduler::shouldDefer() const
+{
+  return isOnBatteryPower() || userIdleTime() >= kLicenseCheckIdleThreshold;
+}
+
+} // namespace synergy::gui::license
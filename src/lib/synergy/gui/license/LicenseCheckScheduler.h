@@ -0,0 +1,90 @@
+/*
+ * Synergy -- mouse and keyboard sharing utility
+ * Copyright (C) 2026 Symless Ltd.
+ *
+ * This package is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * found in the file LICENSE that should have accompanied this file.
+ *
+ * This package is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <QObject>
+#include <QRandomGenerator>
+#include <QString>
+#include <QTimer>
+
+#include <chrono>
+
+namespace synergy::gui::license {
+
+/**
+ * @brief Decides when to run periodic remote license checks.
+ *
+ * Each machine gets a stable slot within the period, derived from its machine
+ * signature, so a fleet that boots at the same time still spreads its checks
+ * evenly. A small random jitter is added on top, and checks are deferred while
+ * the machine is idle or running on battery. Idle time isn't known on Linux (see
+ * `userIdleTime`), so there checks are only deferred on battery.
+ */
+class LicenseCheckScheduler : public QObject
+{
+  Q_OBJECT
+
+  using seconds = std::chrono::seconds;
+  using milliseconds = std::chrono::milliseconds;
+
+public:
+  explicit LicenseCheckScheduler(QObject *parent = nullptr);
+
+  /**
+   * @param lastCheckSecs When the last check completed (seconds since epoch), or 0.
+   *    If that's more than a period ago, the first check is due soon after start.
+   */
+  void start(const QString &machineSignature, seconds period, qint64 lastCheckSecs);
+  void stop();
+
+  bool isActive() const
+  {
+    return m_timer.isActive();
+  }
+
+  static seconds stableOffset(const QString &machineSignature, seconds period);
+  static qint64 nextSlotSecs(qint64 nowSecs, seconds offset, seconds period);
+
+  /**
+   * @brief When the first check after start is due; an overdue check is spread over
+   *    `kLicenseCheckStartupSpread` rather than run the moment the machine boots.
+   */
+  static qint64 firstDueSecs(
+      qint64 nowSecs, qint64 lastCheckSecs, seconds offset, seconds period, QRandomGenerator &random
+  );
+
+  /**
+   * @brief Less than a twentieth of the period, so machines that share a slot drift apart.
+   */
+  static milliseconds jitter(seconds period, QRandomGenerator &random);
+
+signals:
+  void checkDue();
+
+private:
+  void scheduleAt(qint64 dueSecs);
+  void handleTimeout();
+  bool shouldDefer() const;
+
+  QTimer m_timer;
+  seconds m_period{0};
+  seconds m_offset{0};
+  qint64 m_dueSecs = 0;
+};
+
+} // namespace synergy::gui::license
@@ -0,0 +1,276 @@
+/*
+ * Synergy -- mouse and keyboard sharing utility
+ * Copyright (C) 2026 Symless Ltd.
+ *
+ * This package is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * found in the file LICENSE that should have accompanied this file.
+ *
+ * This package is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "LicenseCoordinator.h"
+
+#include "synergy/gui/constants.h"
+#include "synergy/gui/license/LicenseLease.h"
+
+#include <QDateTime>
+#include <QDir>
+#include <QFile>
+#include <QJsonDocument>
+#include <QLockFile>
+#include <QSaveFile>
+#include <QTimer>
+#include <QtCore>
+
+#if !defined(Q_OS_WIN)
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+using namespace std::chrono;
+
+namespace synergy::gui::license {
+
+// Enough of the signature to tell machines apart without making the paths unwieldy.
+const auto kMachineIdLength = 16;
+
+// Other users can read results in the machine-wide dir, but never change them.
+const auto kStatePermissions = QFile::ReadOwner | QFile::WriteOwner | QFile::ReadGroup | QFile::ReadOther;
+
+QString kindKey(LicenseCoordinator::Kind kind)
+{
+  return kind == LicenseCoordinator::Kind::kActivate ? QStringLiteral("activate") : QStringLiteral("check");
+}
+
+// Each user writes their own result file, since in a shared dir they can't replace
+// each other's.
+QString userTag()
+{
+#if defined(Q_OS_WIN)
+  return qEnvironmentVariable("USERNAME");
+#else
+  return QString::number(getuid());
+#endif
+}
+
+LicenseCoordinator::LicenseCoordinator(QObject *parent) : QObject(parent), m_dir(stateDir())
+{
+  if (!QDir(m_dir).mkpath(".")) {
+    qWarning().noquote() << "unable to create license state dir:" << m_dir;
+    return;
+  }
+
+#if !defined(Q_OS_WIN)
+  // Like /tmp: anyone can add files, but only the owner can remove or replace them.
+  // Fails harmlessly if another user created the dir.
+  chmod(QFile::encodeName(m_dir).constData(), 01777);
+#endif
+}
+
+QString LicenseCoordinator::stateDir()
+{
+  // Lets tests avoid sharing results with each other, or with a real install.
+  if (const auto envVar = qEnvironmentVariable("SYNERGY_TEST_LICENSE_STATE_DIR"); !envVar.isEmpty()) {
+    return envVar;
+  }
+
+#if defined(Q_OS_WIN)
+  // Users can add to it, and the creator owns what they add.
+  return QDir(qEnvironmentVariable("ProgramData")).filePath("Synergy/license");
+#else
+  return QStringLiteral("/var/tmp/synergy-license");
+#endif
+}
+
+QFuture<LicenseCoordinator::Result> LicenseCoordinator::run(
+    Kind kind, const QString &machineSignature, const QString &serialKey, const Request &request
+)
+{
+  // Only results with a verified lease are shared, so without a key there's nothing to
+  // wait for; followers would just queue up behind the lock and ask the API anyway.
+  if (leasePublicKey().isEmpty()) {
+    return request();
+  }
+
+  auto flight = std::make_shared<Flight>(Flight{
+      kind, machineSignature, serialKey, LicenseLease::serialHash(serialKey), request,
+      QDateTime::currentSecsSinceEpoch(), std::make_shared<QPromise<Result>>()
+  });
+  flight->promise->start();
+  auto future = flight->promise->future();
+
+  const auto recentSecs = duration_cast<seconds>(kSharedLicenseResultTtl).count();
+  if (const auto result = sharedResult(*flight, flight->startedAtSecs - recentSecs); result.has_value()) {
+    qInfo("reusing recent license %s result from this machine", qPrintable(kindKey(kind)));
+    flight->promise->addResult(result.value());
+    flight->promise->finish();
+    return future;
+  }
+
+  tryLead(flight);
+  return future;
+}
+
+void LicenseCoordinator::tryLead(const std::shared_ptr<Flight> &flight)
+{
+  auto lock = std::make_shared<QLockFile>(lockFilePath(flight->machineSignature));
+  lock->setStaleLockTime(duration_cast<milliseconds>(kLicenseLockStaleTime));
+
+  if (lock->tryLock(0)) {
+    lead(flight, lock);
+  } else if (lock->error() == QLockFile::LockFailedError) {
+    qInfo("another process is contacting the license api, waiting for its result");
+    follow(flight);
+  } else {
+    // Can't share with other processes (e.g. the directory isn't writable), so just
+    // go ahead on our own rather than block licensing.
+    qWarning("unable to take license lock file, error: %d", static_cast<int>(lock->error()));
+    lead(flight, nullptr);
+  }
+}
+
+void LicenseCoordinator::lead(const std::shared_ptr<Flight> &flight, std::shared_ptr<QLockFile> lock)
+{
+  flight->request().then(this, [this, flight, lock](const Result &result) {
+    storeResult(*flight, result);
+    if (lock) {
+      lock->unlock();
+    }
+
+    flight->promise->addResult(result);
+    flight->promise->finish();
+  });
+}
+
+void LicenseCoordinator::follow(const std::shared_ptr<Flight> &flight)
+{
+  const auto deadline = QDateTime::currentMSecsSinceEpoch() + duration_cast<milliseconds>(kLicenseLockWait).count();
+
+  auto timer = new QTimer(this);
+  timer->setInterval(duration_cast<milliseconds>(kLicenseLockPollInterval));
+  connect(timer, &QTimer::timeout, this, [this, timer, flight, deadline] {
+    if (const auto result = sharedResult(*flight, flight->startedAtSecs); result.has_value()) {
+      qInfo("using license %s result from another process", qPrintable(kindKey(flight->kind)));
+      timer->stop();
+      timer->deleteLater();
+      flight->promise->addResult(result.value());
+      flight->promise->finish();
+      return;
+    }
+
+    if (QDateTime::currentMSecsSinceEpoch() >= deadline) {
+      qWarning("timed out waiting for another process to contact the license api");
+      timer->stop();
+      timer->deleteLater();
+      lead(flight, nullptr);
+      return;
+    }
+
+    // The other process may have gone away (or failed) without writing a result,
+    // in which case the lock is free again and this process takes over.
+    auto lock = std::make_shared<QLockFile>(lockFilePath(flight->machineSignature));
+    lock->setStaleLockTime(duration_cast<milliseconds>(kLicenseLockStaleTime));
+    if (lock->tryLock(0)) {
+      qDebug("license lock released without a result, taking over");
+      timer->stop();
+      timer->deleteLater();
+      lead(flight, lock);
+    }
+  });
+  timer->start();
+}
+
+std::optional<LicenseCoordinator::Result> LicenseCoordinator::sharedResult(const Flight &flight, qint64 notBeforeSecs)
+    const
+{
+  // Any user on the machine may have written the newest result.
+  const auto pattern = QString("machine-%1*.json").arg(flight.machineSignature.left(kMachineIdLength));
+  std::optional<Result> newest;
+  qint64 newestSecs = 0;
+  for (const auto &fileName : QDir(m_dir).entryList({pattern}, QDir::Files)) {
+    const auto state = readStateFile(QDir(m_dir).filePath(fileName));
+    const auto entry = state[flight.serialHash].toObject()[kindKey(flight.kind)].toObject();
+    const auto timeSecs = entry["time"].toInteger();
+    if (entry.isEmpty() || timeSecs < notBeforeSecs || timeSecs <= newestSecs) {
+      continue;
+    }
+
+    // The lease is the only part of the entry that can't be forged.
+    const auto token = entry["lease"].toString();
+    const auto lease = LicenseLease::fromToken(token, leasePublicKey());
+    if (!lease.has_value() ||
+        !lease->isValidFor(flight.serialKey, flight.machineSignature, QDateTime::currentSecsSinceEpoch())) {
+      qWarning().noquote() << "shared license result has no valid lease, ignoring:" << fileName;
+      continue;
+    }
+
+    Result result;
+    result.status = Result::Status::kSuccess;
+    result.lease = token;
+    newest = result;
+    newestSecs = timeSecs;
+  }
+
+  return newest;
+}
+
+void LicenseCoordinator::storeResult(const Flight &flight, const Result &result) const
+{
+  // Nothing else can be verified by the processes reading it back.
+  if (result.status != Result::Status::kSuccess || result.lease.isEmpty()) {
+    return;
+  }
+
+  QJsonObject entry;
+  entry["lease"] = result.lease;
+  entry["time"] = QDateTime::currentSecsSinceEpoch();
+
+  const auto path = stateFilePath(flight.machineSignature);
+  auto state = readStateFile(path);
+  auto keyState = state[flight.serialHash].toObject();
+  keyState[kindKey(flight.kind)] = entry;
+  state[flight.serialHash] = keyState;
+
+  QSaveFile file(path);
+  if (!file.open(QIODevice::WriteOnly)) {
+    qWarning().noquote() << "unable to write shared license state:" << path;
+    return;
+  }
+
+  file.setPermissions(kStatePermissions);
+  file.write(QJsonDocument(state).toJson(QJsonDocument::Compact));
+  if (!file.commit()) {
+    qWarning().noquote() << "unable to save shared license state:" << path;
+  }
+}
+
+QString LicenseCoordinator::stateFilePath(const QString &machineSignature) const
+{
+  return QDir(m_dir).filePath(
+      QString("machine-%1-%2.json").arg(machineSignature.left(kMachineIdLength), userTag())
+  );
+}
+
+QString LicenseCoordinator::lockFilePath(const QString &machineSignature) const
+{
+  return QDir(m_dir).filePath(QString("machine-%1.lock").arg(machineSignature.left(kMachineIdLength)));
+}
+
+QJsonObject LicenseCoordinator::readStateFile(const QString &path)
+{
+  QFile file(path);
+  if (!file.open(QIODevice::ReadOnly)) {
+    return {};
+  }
+
+  return QJsonDocument::fromJson(file.readAll()).object();
+}
+
+} // namespace synergy::gui::license
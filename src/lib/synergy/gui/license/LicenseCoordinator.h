@@ -0,0 +1,99 @@
+/*
+ * Synergy -- mouse and keyboard sharing utility
+ * Copyright (C) 2026 Symless Ltd.
+ *
+ * This package is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * found in the file LICENSE that should have accompanied this file.
+ *
+ * This package is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include "synergy/gui/license/LicenseApiClient.h"
+
+#include <QFuture>
+#include <QJsonObject>
+#include <QObject>
+#include <QString>
+
+#include <functional>
+#include <memory>
+#include <optional>
+
+class QLockFile;
+
+namespace synergy::gui::license {
+
+/**
+ * @brief Makes sure only one process on the machine talks to the license API at a time.
+ *
+ * Several GUI processes may run on one machine (e.g. user and system scope, or several
+ * users on a terminal server), each with the same serial key. The first one to take the
+ * lock file sends the request and writes the result to a state file; the others wait
+ * for that result instead of sending their own.
+ *
+ * The state dir is machine-wide and anyone can add to it, so only successful results
+ * are shared, and only while their lease verifies. Any other result is not shared, so a
+ * waiting process takes the lock and asks the API itself. Builds without a lease key
+ * can't verify anything, so every request goes straight to the API.
+ *
+ * A lock left by another user's crashed process can't be removed, so in that case
+ * processes wait `kLicenseLockWait` and then go ahead on their own.
+ */
+class LicenseCoordinator : public QObject
+{
+  Q_OBJECT
+
+  using Result = LicenseApiClient::Result;
+
+public:
+  enum class Kind
+  {
+    kActivate,
+    kCheck
+  };
+
+  using Request = std::function<QFuture<Result>()>;
+
+  explicit LicenseCoordinator(QObject *parent = nullptr);
+
+  /**
+   * @brief Runs the request, or reuses a recent or in-flight result from another process.
+   */
+  QFuture<Result> run(Kind kind, const QString &machineSignature, const QString &serialKey, const Request &request);
+
+  static QString stateDir();
+
+private:
+  struct Flight
+  {
+    Kind kind;
+    QString machineSignature;
+    QString serialKey;
+    QString serialHash;
+    Request request;
+    qint64 startedAtSecs;
+    std::shared_ptr<QPromise<Result>> promise;
+  };
+
+  void tryLead(const std::shared_ptr<Flight> &flight);
+  void lead(const std::shared_ptr<Flight> &flight, std::shared_ptr<QLockFile> lock);
+  void follow(const std::shared_ptr<Flight> &flight);
+  std::optional<Result> sharedResult(const Flight &flight, qint64 notBeforeSecs) const;
+  void storeResult(const Flight &flight, const Result &result) const;
+  QString stateFilePath(const QString &machineSignature) const;
+  QString lockFilePath(const QString &machineSignature) const;
+  static QJsonObject readStateFile(const QString &path);
+
+  QString m_dir;
+};
+
+} // namespace synergy::gui::license
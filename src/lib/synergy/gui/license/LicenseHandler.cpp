@@ -22,29 +22,36 @@
 #include "gui/config/AppConfig.h"
 #include "gui/core/CoreProcess.h"
 #include "gui/styles.h"
+#include "synergy/gui/StallWatchdog.h"
 #include "synergy/gui/constants.h"
+#include "synergy/gui/license/LicenseAuditLog.h"
+#include "synergy/gui/license/LicenseLease.h"
+#include "synergy/gui/license/LicenseMetrics.h"
+#include "synergy/gui/license/LicenseStatusServer.h"
 #include "synergy/gui/license/license_utils.h"
+#include "synergy/gui/trace.h"
 #include "synergy/license/Product.h"
 #include "version.h"
 
 #include <QAction>
 #include <QCheckBox>
 #include <QCoreApplication>
-#include <QCryptographicHash>
 #include <QDateTime>
 #include <QDebug>
 #include <QDialog>
-#include <QHostInfo>
 #include <QMainWindow>
 #include <QMenuBar>
 #include <QMessageBox>
 #include <QObject>
 #include <QProcessEnvironment>
+#include <QPromise>
 #include <QRadioButton>
-#include <QSysInfo>
+#include <QRandomGenerator>
 #include <QTimer>
 #include <QtCore>
+#include <algorithm>
 #include <chrono>
+#include <memory>
 
 using namespace std::chrono;
 using namespace synergy::gui::license;
@@ -52,49 +59,122 @@ using namespace synergy::gui;
 using namespace deskflow::gui;
 using License = synergy::license::License;
 
+// Later notices with the same key replace earlier ones still on screen.
+const auto kActivationNotice = QStringLiteral("activation");
+const auto kLicenseStatusNotice = QStringLiteral("licenseStatus");
+
+static std::optional<system_clock::time_point> graceStartFromSecs(qint64 graceStartEpochSecs)
+{
+  if (graceStartEpochSecs <= 0) {
+    return std::nullopt;
+  }
+  return system_clock::time_point{seconds{graceStartEpochSecs}};
+}
+
+static microseconds elapsedMicros(const QElapsedTimer &timer)
+{
+  return duration_cast<microseconds>(nanoseconds{timer.nsecsElapsed()});
+}
+
+// For requests made once the API thread has stopped, e.g. by the relay during shutdown.
+static QFuture<LicenseApiClient::Result> canceledRequest()
+{
+  LicenseApiClient::Result result;
+  result.status = LicenseApiClient::Result::Status::kCanceled;
+
+  QPromise<LicenseApiClient::Result> promise;
+  promise.start();
+  promise.addResult(result);
+  promise.finish();
+  return promise.future();
+}
+
 LicenseHandler::LicenseHandler()
 {
   m_enabled = synergy::gui::license::isActivationEnabled();
-
-  connect(&m_apiClient, &LicenseApiClient::activationFailed, this, [this](const QString &message) {
-    QString fullMessage = QString(
-                              "<p>There was a problem activating your license.</p>"
-                              "%3"
-                              R"(<p>Please <a href="%1" style="color: %2">contact us</a> )"
-                              "if there is anything we can do to help.</p>"
-    )
-                              .arg(kUrlContact)
-                              .arg(kColorSecondary)
-                              .arg(message);
-    QMessageBox::warning(m_pMainWindow, "Activation failed", fullMessage);
-
-    qWarning("activation failed, showing serial key dialog");
-    return showSerialKeyDialog();
+  m_startupTimer.start();
+
+  // Disk reads can be slow (e.g. roaming profiles), so start now and only wait when
+  // something needs the result, rather than before the window can paint. The worker reads
+  // its own copy of the settings file, and `waitForStartup` applies what it read on this
+  // thread. The fingerprint is worked out likewise.
+  m_settingsLoad = runInBackground<SettingsLoad>(
+      [fileName = m_settings.activeFileName(), format = m_settings.activeFormat()] {
+        QElapsedTimer timer;
+        timer.start();
+        auto snapshot = ExtraSettings::read(fileName, format);
+        return SettingsLoad{std::move(snapshot), elapsedMicros(timer)};
+      }
+  );
+
+  // Network I/O and response parsing happen on the API thread; results come back as
+  // futures whose continuations use this object as context, so they run on the GUI thread.
+  m_apiClient = new LicenseApiClient();
+  m_apiClient->moveToThread(&m_apiThread);
+  connect(&m_apiThread, &QThread::finished, m_apiClient, &QObject::deleteLater);
+  m_apiThread.setObjectName("license-api");
+  m_apiThread.start();
+
+  connect(&m_leaseRenewTimer, &QTimer::timeout, this, &LicenseHandler::renewLease);
+  m_activationRetryTimer.setSingleShot(true);
+  connect(&m_activationRetryTimer, &QTimer::timeout, this, &LicenseHandler::retryActivation);
+  connect(&m_checkScheduler, &LicenseCheckScheduler::checkDue, this, &LicenseHandler::runRemoteCheck);
+
+  connect(&m_stateChannel, &LicenseStateChannel::stateReceived, this, &LicenseHandler::applySharedState);
+  connect(&m_stateChannel, &LicenseStateChannel::activationRequested, this, [this] {
+    if (!m_settings.activated() && m_license.isValid() && !m_license.serialKey().isOffline && !m_activationInFlight) {
+      qInfo("activating license for another process");
+      activate();
+    }
   });
+  // Queued, so host duties never start from inside the channel's own socket handling.
+  connect(
+      &m_stateChannel, &LicenseStateChannel::roleDecided, this,
+      [this](LicenseStateChannel::Role role) {
+        if (role == LicenseStateChannel::Role::kSubscriber) {
+          qDebug("license is handled by another process, skipping remote checks");
+          return;
+        }
+        startHostDuties();
+      },
+      Qt::QueuedConnection
+  );
+
+  if (QCoreApplication::instance() != nullptr) {
+    connect(QCoreApplication::instance(), &QCoreApplication::aboutToQuit, this, &LicenseHandler::stopApiThread);
+    connect(QCoreApplication::instance(), &QCoreApplication::aboutToQuit, &m_settings, &ExtraSettings::sync);
+  }
+}
 
-  connect(&m_apiClient, &LicenseApiClient::activationSucceeded, this, [this] {
-    qDebug("license activation succeeded, saving settings");
-    m_settings.setActivated(true);
-    m_settings.setGraceStartEpochSecs(0);
-    m_settings.sync();
-    m_warnedAboutGrace = false;
+LicenseHandler::~LicenseHandler()
+{
+  // Not left reading the disk while the app shuts down.
+  m_settingsLoad.waitForFinished();
+  stopApiThread();
+}
 
-    if (m_pCoreProcess == nullptr) {
-      qFatal("core process not set");
-    }
+void LicenseHandler::stopApiThread()
+{
+  if (!m_apiThread.isRunning()) {
+    return;
+  }
 
-    if (m_pCoreProcess->mode() == CoreProcess::Mode::None) {
-      qDebug("no core mode selected, not resuming core process after activation");
-      return;
-    }
+  qDebug("stopping license api thread");
 
-    qDebug("resuming core process after activation");
-    m_pCoreProcess->start();
-  });
+  // Nothing may start a request once the client has gone.
+  m_leaseRenewTimer.stop();
+  m_activationRetryTimer.stop();
+  m_checkScheduler.stop();
+  if (m_seatReporter != nullptr) {
+    m_seatReporter->stop();
+  }
 
-  connect(&m_apiClient, &LicenseApiClient::checkSucceeded, this, &LicenseHandler::handleRemoteCheckSucceeded);
-  connect(&m_apiClient, &LicenseApiClient::checkFailed, this, &LicenseHandler::handleRemoteCheckFailed);
-  connect(&m_apiClient, &LicenseApiClient::licenseDisabled, this, &LicenseHandler::disableLicenseRemotely);
+  m_apiClient->cancelAll();
+  m_apiThread.quit();
+  m_apiThread.wait();
+
+  // The client is deleted by the thread's finished signal.
+  m_apiClient = nullptr;
 }
 
 void LicenseHandler::handleMainWindow(
@@ -103,6 +183,7 @@ void LicenseHandler::handleMainWindow(
 {
   // Must still be set as these are used when not enabled.
   m_pMainWindow = mainWindow;
+  m_notifier.setParentWidget(mainWindow);
   m_pAppConfig = appConfig;
   m_pCoreProcess = coreProcess;
 
@@ -111,13 +192,53 @@ void LicenseHandler::handleMainWindow(
     return;
   }
 
+  // Nothing is left to show the results to once the window has gone.
+  connect(mainWindow, &QObject::destroyed, this, [this] {
+    if (m_apiClient != nullptr) {
+      qDebug("main window destroyed, canceling license requests");
+      m_apiClient->cancelAll();
+    }
+  });
+
+  // Only to measure startup; removed again after the first paint.
+  mainWindow->installEventFilter(this);
+
   qDebug("main window create handled");
+}
 
-  if (!loadSettings()) {
-    qFatal("failed to load license settings");
+void LicenseHandler::waitForStartup()
+{
+  StallWatchdog::Scope scope("LicenseHandler::waitForStartup");
+  if (m_startupDone) {
+    return;
+  }
+  m_startupDone = true;
+
+  QElapsedTimer timer;
+  timer.start();
+  auto load = m_settingsLoad.takeResult();
+  m_settings.apply(std::move(load.snapshot));
+  m_settingsLoadTime = load.time;
+  m_startupBlocking += elapsedMicros(timer);
+
+  // An invalid key is dealt with by `check` on app start, so no dialog is shown here.
+  if (!applySettings(false)) {
+    qWarning("serial key in settings is not valid");
   }
 }
 
+bool LicenseHandler::eventFilter(QObject *watched, QEvent *event)
+{
+  if (watched == m_pMainWindow && event->type() == QEvent::Paint) {
+    m_pMainWindow->removeEventFilter(this);
+    qInfo(
+        "main window first paint after %lld ms, license startup blocked gui thread for %lld ms",
+        m_startupTimer.elapsed(), static_cast<qint64>(duration_cast<milliseconds>(m_startupBlocking).count())
+    );
+  }
+  return QObject::eventFilter(watched, event);
+}
+
 bool LicenseHandler::handleAppStart()
 {
   if (m_pMainWindow == nullptr) {
@@ -134,6 +255,17 @@ bool LicenseHandler::handleAppStart()
     return true;
   }
 
+  QElapsedTimer timer;
+  timer.start();
+  const auto result = startLicensing();
+  m_startupBlocking += elapsedMicros(timer);
+  return result;
+}
+
+bool LicenseHandler::startLicensing()
+{
+  StallWatchdog::Scope scope("LicenseHandler::startLicensing");
+  waitForStartup();
   updateWindowTitle();
 
   const auto serialKeyAction = new QAction("Change serial key", m_pMainWindow);
@@ -151,20 +283,46 @@ bool LicenseHandler::handleAppStart()
   qDebug("license is valid, continuing with start");
   updateWindowTitle();
   clampFeatures();
-  runRemoteCheck();
+
+  // In system scope, one process handles the license for every user on the machine;
+  // whether that's this one is decided without blocking, see `roleDecided`.
+  if (m_pAppConfig->isSystemScope()) {
+    m_stateChannel.start();
+    return true;
+  }
+
+  // Nothing here gates the UI, so let the window paint first.
+  QTimer::singleShot(0, this, &LicenseHandler::startHostDuties);
   return true;
 }
 
+void LicenseHandler::startHostDuties()
+{
+  // Also called when a subscriber takes over from a host that went away, so this has to
+  // leave it in the same state as a process that was the host from the start.
+  m_appStarted = true;
+  activateSpeculatively();
+
+  startRemoteChecks();
+  startLicenseRelay();
+  startSeatUsageReports();
+  startStatusServer();
+  publishState();
+}
+
 void LicenseHandler::handleSettings(
     QDialog *parent, QCheckBox *enableTls, QCheckBox *invertConnection, QRadioButton *systemScope,
     QRadioButton *userScope
-) const
+)
 {
   if (!m_enabled) {
     qDebug("license handler disabled, skipping settings handler");
     return;
   }
 
+  // The checkboxes are checked against the license, so it must have been loaded.
+  waitForStartup();
+
   const auto onTlsToggle = [this, parent, enableTls] {
     qDebug("license handler, tls checkbox toggled");
     checkTlsCheckBox(parent, enableTls, true);
@@ -188,6 +346,7 @@ void LicenseHandler::handleVersionCheck(QString &versionUrl)
     return;
   }
 
+  waitForStartup();
   const auto edition = license().productEdition();
   if (edition == Product::Edition::kBusiness) {
     versionUrl.append("/business");
@@ -215,6 +374,8 @@ bool LicenseHandler::handleCoreStart()
     qFatal("core process not set");
   }
 
+  waitForStartup();
+
   if (m_settings.activated()) {
     qDebug("license is activated, starting core");
     return true;
@@ -232,27 +393,67 @@ bool LicenseHandler::handleCoreStart()
 
   // HACK: For some reason, the core start trigger gets called twice when clicking the 'start' button.
   // If the activator is called twice in quick succession, the core is started twice.
-  if (m_apiClient.isBusy()) {
+  if (m_activationInFlight && !m_activationSpeculative) {
     qDebug("activator is busy, skipping core start handler");
     return false;
   }
 
+  if (applySpeculativeActivation()) {
+    qDebug("license was activated in the background, starting core");
+    return true;
+  }
+
+  m_activationTrace = {};
+  m_activationTrace.settingsLoad = m_settingsLoadTime;
+  m_activationTimer.start();
+
+  // The key has already been checked locally, so it's very likely to be accepted; don't
+  // make the user wait for the server (or for the network to come back) to start sharing.
+  // A rejection found in the background is reported instead. Not once a grace period
+  // spent running unactivated is over, though; then only a real activation will do.
+  m_optimisticStart = isOptimisticStartEnabled(m_settings.optimisticStart()) && !m_license.isExpired() &&
+                      !hasSpeculativeResult() && !isGracePeriodExpired();
+  if (m_optimisticStart) {
+    qInfo("activating license, starting core without waiting");
+    activate();
+    return true;
+  }
+
   qInfo("activating license");
-  m_apiClient.activate(buildApiData());
+  activate();
 
   return false;
 }
 
 bool LicenseHandler::loadSettings()
 {
-  using enum SetSerialKeyResult;
+  trace::Span span("LicenseHandler::loadSettings");
+
+  // The first load was started in the background on construction; only read the disk
+  // again if that has already been used, e.g. to pick up changes made elsewhere.
+  if (m_startupDone) {
+    QElapsedTimer timer;
+    timer.start();
+    m_settings.load();
+    m_settingsLoadTime = elapsedMicros(timer);
+  } else {
+    waitForStartup();
+  }
+
+  return applySettings(true);
+}
 
-  m_settings.load();
+bool LicenseHandler::applySettings(bool showDialog)
+{
+  using enum SetSerialKeyResult;
 
   const auto serialKey = m_settings.serialKey();
   if (!serialKey.isEmpty()) {
     const auto result = setLicense(m_settings.serialKey(), true);
     if (result != kSuccess && result != kUnchanged) {
+      if (!showDialog) {
+        return false;
+      }
       qWarning("set serial key failed, showing activation dialog");
       return showSerialKeyDialog();
     }
@@ -263,13 +464,20 @@ bool LicenseHandler::loadSettings()
 
 void LicenseHandler::saveSettings()
 {
-  const auto hexString = m_license.serialKey().hexString;
-  m_settings.setSerialKey(QString::fromStdString(hexString));
-  m_settings.sync();
+  waitForStartup();
+  const auto serialKey = QString::fromStdString(m_license.serialKey().hexString);
+  if (serialKey != m_settings.serialKey()) {
+    // Only a hash of the key, as the log may be sent to support.
+    const auto hash = LicenseLease::serialHash(serialKey).left(16).toLatin1();
+    LicenseAuditLog::instance().append({.type = LicenseAuditLog::Type::kSerialKeyChanged, .detail = hash});
+  }
+  m_settings.setSerialKey(serialKey);
+  syncSettings();
 }
 
 bool LicenseHandler::showSerialKeyDialog()
 {
+  StallWatchdog::Scope scope("LicenseHandler::showSerialKeyDialog");
   if (!m_settings.isWritable()) {
     QMessageBox::warning(
         m_pMainWindow, "Write access required",
@@ -288,13 +496,14 @@ bool LicenseHandler::showSerialKeyDialog()
     return false;
   }
 
+  ExtraSettings::Transaction transaction(m_settings);
   if (dialog.serialKeyChanged()) {
     // Reset activation so new serial key can be activated.
     qDebug("serial key changed, updating settings");
-    m_settings.setActivated(false);
-    m_settings.setGraceStartEpochSecs(0);
+    saveLifecycle();
+    m_settings.setLease("");
     m_warnedAboutGrace = false;
-    m_settings.sync();
+    syncSettings();
   }
 
   saveSettings();
@@ -309,9 +518,10 @@ bool LicenseHandler::showSerialKeyDialog()
   // If the user accepted the dialog while not activated (e.g. recovering from a
   // remote disable), retry activation so something visible happens regardless of
   // whether the serial key changed.
-  if (!m_settings.activated() && m_license.isValid() && !m_license.serialKey().isOffline && !m_apiClient.isBusy()) {
+  if (!m_settings.activated() && m_license.isValid() && !m_license.serialKey().isOffline) {
     qInfo("retrying activation after dialog accept");
-    m_apiClient.activate(buildApiData());
+    LicenseMetrics::instance().recordRetry(LicenseMetrics::Retry::kActivation);
+    activate();
   }
 
   qDebug("license serial key dialog accepted");
@@ -362,13 +572,16 @@ void LicenseHandler::checkInvertConnectionCheckBox(
   }
 }
 
-const synergy::license::License &LicenseHandler::license() const
+const synergy::license::License &LicenseHandler::license()
 {
+  // Until the settings have loaded, this would be the invalid placeholder license.
+  waitForStartup();
   return m_license;
 }
 
-Product::Edition LicenseHandler::productEdition() const
+Product::Edition LicenseHandler::productEdition()
 {
+  waitForStartup();
   return m_license.productEdition();
 }
 
@@ -381,6 +594,7 @@ QString LicenseHandler::productName() const
 ///     Useful for passing an expired license to the activation dialog.
 LicenseHandler::SetSerialKeyResult LicenseHandler::setLicense(const QString &hexString, bool allowExpired)
 {
+  StallWatchdog::Scope scope("LicenseHandler::setLicense");
   using enum LicenseHandler::SetSerialKeyResult;
 
   if (hexString.isEmpty()) {
@@ -409,6 +623,16 @@ LicenseHandler::SetSerialKeyResult LicenseHandler::setLicense(const QString &hex
   const auto oldSerialKey = m_license.serialKey();
   m_license = license;
 
+  // A new key starts out unactivated; the saved state only belongs to the saved key.
+  m_lifecycle.emplace(serialKey, duration_cast<seconds>(kLicenseGracePeriod), [this] { return m_time.now(); });
+  if (hexString == m_settings.serialKey()) {
+    restoreLifecycle();
+  }
+
+  if (m_seatReporter != nullptr) {
+    m_seatReporter->setSeatLimit(serialKey.seats);
+  }
+
   // This delayed check logic seems really complex. Is it really worth the maintenance and testing cost?
   // Condition must run *after* the license member is set, since it's async callback uses this member.
   if (!m_license.isExpired() && m_license.isTimeLimited()) {
@@ -427,11 +651,17 @@ LicenseHandler::SetSerialKeyResult LicenseHandler::setLicense(const QString &hex
     return kUnchanged;
   }
 
+  // E.g. a key typed into the activation dialog; it's activated while the user finishes up.
+  if (m_appStarted) {
+    activateSpeculatively();
+  }
+
   return kSuccess;
 }
 
 bool LicenseHandler::check()
 {
+  trace::Span span("LicenseHandler::check");
   if (!m_license.isValid()) {
     qDebug("license validation failed, license invalid");
     return showSerialKeyDialog();
@@ -443,9 +673,9 @@ bool LicenseHandler::check()
       qDebug("license expiring soon but in remote grace period, suppressing renew nag");
       return true;
     }
+    // Expiring soon licenses are still valid, so the nag can wait until the window is up.
     qDebug("license is expiring soon, showing serial key dialog");
-    showSerialKeyDialog();
-    // Return true even if dialog cancelled, since expiring soon licenses are still valid.
+    QTimer::singleShot(0, this, [this] { showSerialKeyDialog(); });
     return true;
   } else {
     qDebug("license validation succeeded");
@@ -455,19 +685,34 @@ bool LicenseHandler::check()
 
 void LicenseHandler::clampFeatures()
 {
+  trace::Span span("LicenseHandler::clampFeatures");
+  auto changed = false;
+
   if (m_pAppConfig->tlsEnabled() && !m_license.isTlsAvailable()) {
     qWarning("tls not available, disabling tls");
     m_pAppConfig->setTlsEnabled(false);
+    LicenseAuditLog::instance().append({.type = LicenseAuditLog::Type::kFeatureClamped, .detail = "tls"});
+    changed = true;
   }
 
   if (m_pAppConfig->invertConnection() && !m_license.isInvertConnectionAvailable()) {
     qWarning("invert connection not available, disabling invert connection");
     m_pAppConfig->setInvertConnection(false);
+    LicenseAuditLog::instance().append({.type = LicenseAuditLog::Type::kFeatureClamped, .detail = "invertConnection"});
+    changed = true;
   }
 
   if (m_pAppConfig->isSystemScope() && !m_license.isSettingsScopeAvailable()) {
     qWarning("settings scope not available, reverting to user scope");
     m_pAppConfig->setIsSystemScope(false);
+    LicenseAuditLog::instance().append({.type = LicenseAuditLog::Type::kFeatureClamped, .detail = "settingsScope"});
+    changed = true;
+  }
+
+  // Committing rewrites the whole config, so skip it when nothing was clamped.
+  if (!changed) {
+    qDebug("feature settings unchanged, not committing");
+    return;
   }
 
   qDebug("committing default feature settings");
@@ -482,38 +727,449 @@ void LicenseHandler::disable()
 
 bool LicenseHandler::isInGracePeriod() const
 {
-  return m_settings.graceStartEpochSecs() > 0;
+  return m_lifecycle.has_value() && m_lifecycle->isInGracePeriod();
 }
 
 bool LicenseHandler::isGracePeriodExpired() const
 {
-  if (!isInGracePeriod()) {
-    return false;
+  return m_lifecycle.has_value() && m_lifecycle->isGracePeriodExpired();
+}
+
+qint64 LicenseHandler::nowSecs() const
+{
+  return duration_cast<seconds>(m_time.now().time_since_epoch()).count();
+}
+
+void LicenseHandler::restoreLifecycle()
+{
+  if (m_lifecycle.has_value()) {
+    m_lifecycle->restore(m_settings.activated(), graceStartFromSecs(m_settings.graceStartEpochSecs()));
   }
-  const auto now = QDateTime::currentSecsSinceEpoch();
-  const auto elapsed = seconds{now - m_settings.graceStartEpochSecs()};
-  return elapsed >= duration_cast<seconds>(kLicenseGracePeriod);
 }
 
-LicenseApiClient::Data LicenseHandler::buildApiData() const
+void LicenseHandler::saveLifecycle()
+{
+  if (!m_lifecycle.has_value()) {
+    m_settings.setActivated(false);
+    m_settings.setGraceStartEpochSecs(0);
+    return;
+  }
+
+  const auto graceStart = m_lifecycle->graceStart();
+  m_settings.setActivated(m_lifecycle->isActivated());
+  m_settings.setGraceStartEpochSecs(
+      graceStart.has_value() ? duration_cast<seconds>(graceStart->time_since_epoch()).count() : 0
+  );
+}
+
+QString LicenseHandler::serialKeyString() const
 {
-  const auto machineId = QSysInfo::machineUniqueId();
-  const auto hostname = QHostInfo::localHostName();
+  return QString::fromStdString(m_license.serialKey().hexString);
+}
 
-  // Anonymise so a leak doesn't reveal which customer machine the data belongs to.
-  const auto machineSignature = QCryptographicHash::hash(machineId, QCryptographicHash::Sha256).toHex();
-  const auto hostnameSignature = QCryptographicHash::hash(hostname.toUtf8(), QCryptographicHash::Sha256).toHex();
+QString LicenseHandler::machineSignature() const
+{
+  StallWatchdog::Scope scope("LicenseHandler::machineSignature");
+  return m_fingerprint.values().machineSignature;
+}
 
+LicenseApiClient::Data LicenseHandler::buildApiData() const
+{
+  trace::Span span("LicenseHandler::buildApiData");
+  if (!m_fingerprint.isReady()) {
+    qDebug("waiting for machine fingerprint");
+  }
+
+  const auto fingerprint = m_fingerprint.values();
   return {
-      machineSignature,
-      hostnameSignature,
+      fingerprint.machineSignature,
+      fingerprint.hostnameSignature,
       QString::fromStdString(m_license.serialKey().hexString),
       kVersion,
-      QSysInfo::prettyProductName(),
+      fingerprint.osName,
       m_pAppConfig->serverGroupChecked()
   };
 }
 
+void LicenseHandler::activate(bool speculative)
+{
+  if (m_apiClient == nullptr) {
+    qDebug("license api stopped, not activating");
+    return;
+  }
+
+  if (m_stateChannel.role() == LicenseStateChannel::Role::kSubscriber) {
+    qInfo("asking license host process to activate");
+    m_stateChannel.requestActivation();
+    return;
+  }
+
+  // Only one activation per key ever goes to the API; asking again while one is in flight
+  // (or after a background one finished) takes over its result instead.
+  const auto serialKey = serialKeyString();
+  if (m_activationInFlight && m_activationSerialKey == serialKey) {
+    if (!speculative && m_activationSpeculative) {
+      qDebug("license is already activating in the background, waiting for the result");
+      m_activationSpeculative = false;
+    }
+    return;
+  }
+
+  if (!speculative && hasSpeculativeResult()) {
+    qDebug("using result of background license activation");
+    const auto result = m_speculativeResult->result;
+    m_speculativeResult.reset();
+    handleActivationResult(result);
+    return;
+  }
+
+  using Kind = LicenseCoordinator::Kind;
+
+  QElapsedTimer timer;
+  timer.start();
+  const auto data = buildApiData();
+  m_activationTrace.fingerprint = elapsedMicros(timer);
+
+  m_activationInFlight = true;
+  m_activationSpeculative = speculative;
+  m_activationSerialKey = serialKey;
+
+  LicenseMetrics::instance().recordAttempt(LicenseMetrics::Operation::kActivation);
+  m_coordinator
+      .run(
+          Kind::kActivate, data.machineSignature, data.serialKey,
+          [this, data] { return m_apiClient != nullptr ? m_apiClient->activate(data) : canceledRequest(); }
+      )
+      .then(this, [this, serialKey](const LicenseApiClient::Result &result) {
+        LicenseMetrics::instance().recordResult(LicenseMetrics::Operation::kActivation, result.status);
+        LicenseAuditLog::instance().append(LicenseAuditLog::resultEvent(
+            LicenseAuditLog::Type::kActivationResult, result.status, result.timings.total(), result.message.toUtf8()
+        ));
+
+        // A newer activation may already be in flight, and it owns the in-flight state.
+        if (serialKey != m_activationSerialKey) {
+          qDebug("ignoring license activation result for previous serial key");
+          return;
+        }
+
+        m_activationInFlight = false;
+        if (serialKey != serialKeyString()) {
+          qDebug("serial key changed during activation, ignoring result");
+          return;
+        }
+
+        if (m_activationSpeculative) {
+          handleSpeculativeActivationResult(serialKey, result);
+        } else {
+          handleActivationResult(result);
+        }
+      });
+}
+
+void LicenseHandler::activateSpeculatively()
+{
+  if (!m_enabled || !m_license.isValid() || m_license.serialKey().isOffline || m_license.isExpired()) {
+    return;
+  }
+
+  // Settings may still be for the previous key, e.g. while the activation dialog is open.
+  const auto serialKey = serialKeyString();
+  if (m_settings.activated() && m_settings.serialKey() == serialKey) {
+    return;
+  }
+
+  if (m_stateChannel.role() == LicenseStateChannel::Role::kSubscriber || hasSpeculativeResult()) {
+    return;
+  }
+
+  // Most users click start soon after a valid key is known, so by then this has
+  // usually finished and the core can start without waiting for the network.
+  qInfo("activating license in the background");
+  activate(true);
+}
+
+void LicenseHandler::handleSpeculativeActivationResult(
+    const QString &serialKey, const LicenseApiClient::Result &result
+)
+{
+  using enum LicenseApiClient::Result::Status;
+
+  if (result.status == kNetworkError || result.status == kCanceled) {
+    qDebug("background license activation did not finish, will activate on start");
+    return;
+  }
+
+  // Rejections are kept until the user clicks start, so they're reported when it matters.
+  m_speculativeResult = SpeculativeResult{serialKey, result};
+
+  if (result.status == kSuccess && serialKey == m_settings.serialKey()) {
+    applySpeculativeActivation();
+  }
+}
+
+bool LicenseHandler::hasSpeculativeResult() const
+{
+  return m_speculativeResult.has_value() && m_speculativeResult->serialKey == serialKeyString();
+}
+
+bool LicenseHandler::applySpeculativeActivation()
+{
+  if (!hasSpeculativeResult() || m_speculativeResult->result.status != LicenseApiClient::Result::Status::kSuccess) {
+    return false;
+  }
+
+  qInfo("background license activation succeeded");
+  const auto lease = m_speculativeResult->result.lease;
+  m_speculativeResult.reset();
+  saveActivation(lease);
+  return true;
+}
+
+void LicenseHandler::handleActivationResult(const LicenseApiClient::Result &result)
+{
+  StallWatchdog::Scope scope("LicenseHandler::handleActivationResult");
+  QElapsedTimer timer;
+  timer.start();
+  m_activationTrace.network = result.timings;
+
+  const auto optimisticStart = m_optimisticStart;
+  m_optimisticStart = false;
+
+  switch (result.status) {
+    using enum LicenseApiClient::Result::Status;
+
+  case kSuccess:
+    handleActivationSucceeded(result.lease);
+    break;
+
+  case kDisabled:
+    disableLicenseRemotely(result.message);
+    break;
+
+  case kCanceled:
+    qDebug("license activation canceled");
+    break;
+
+  case kNetworkError:
+    if (optimisticStart) {
+      handleOptimisticActivationError(result.message);
+      break;
+    }
+    handleActivationFailed(result.message);
+    break;
+
+  default:
+    if (optimisticStart && m_pCoreProcess->isStarted()) {
+      qWarning("license rejected, stopping core that was started before activation");
+      m_pCoreProcess->stop();
+    }
+    handleActivationFailed(result.message);
+  }
+
+  // Core start is timed separately, since it's not part of handling the response.
+  m_activationTrace.responseHandling = elapsedMicros(timer) - m_activationTrace.coreStart;
+  finishActivationTrace();
+}
+
+void LicenseHandler::finishActivationTrace()
+{
+  // Only activations triggered by starting the core are traced end-to-end.
+  if (!m_activationTimer.isValid()) {
+    return;
+  }
+
+  m_activationTrace.total = elapsedMicros(m_activationTimer);
+  m_activationTimer.invalidate();
+
+  const auto json = QJsonDocument(m_activationTrace.toJson()).toJson(QJsonDocument::Compact);
+  qDebug().noquote() << "activation trace:" << json;
+  Q_EMIT activationTraced(m_activationTrace);
+}
+
+void LicenseHandler::handleActivationSucceeded(const QString &lease)
+{
+  qDebug("license activation succeeded, saving settings");
+  saveActivation(lease);
+  resumeCoreProcess();
+}
+
+void LicenseHandler::saveActivation(const QString &lease)
+{
+  if (isInGracePeriod()) {
+    LicenseAuditLog::instance().append({.type = LicenseAuditLog::Type::kGraceCleared, .detail = "activation"});
+  }
+  if (m_lifecycle.has_value()) {
+    m_lifecycle->activate();
+  }
+  saveLifecycle();
+  storeLease(lease);
+  syncSettings();
+  m_warnedAboutGrace = false;
+  m_activationFailures = 0;
+  m_activationRetryTimer.stop();
+}
+
+void LicenseHandler::handleOptimisticActivationError(const QString &message)
+{
+  // The server hasn't rejected the key, so sharing carries on, but only for the grace
+  // period. Its start is saved, so restarting the app doesn't give another one.
+  if (!isInGracePeriod() && m_lifecycle.has_value()) {
+    m_lifecycle->checkFailed();
+    saveLifecycle();
+    syncSettings();
+    LicenseAuditLog::instance().append(
+        {.type = LicenseAuditLog::Type::kGraceStarted, .value = m_settings.graceStartEpochSecs()}
+    );
+  }
+
+  if (isGracePeriodExpired()) {
+    qWarning("license not activated within the grace period, stopping core");
+    if (m_pCoreProcess->isStarted()) {
+      m_pCoreProcess->stop();
+    }
+    handleActivationFailed(message);
+    return;
+  }
+
+  m_activationFailures++;
+  const auto delay = LicenseApiClient::retryDelay(
+      m_activationFailures, activationRetryDelay(), kLicenseActivationMaxRetryDelay, *QRandomGenerator::global()
+  );
+  qWarning(
+      "license activation failed with network error, leaving core running, retrying in %lld ms",
+      static_cast<long long>(delay.count())
+  );
+  m_activationRetryTimer.start(delay);
+}
+
+void LicenseHandler::retryActivation()
+{
+  if (m_settings.activated() || m_activationInFlight) {
+    return;
+  }
+
+  LicenseMetrics::instance().recordRetry(LicenseMetrics::Retry::kActivation);
+
+  // If the user has stopped the core since, activating must not start it again.
+  if (m_pCoreProcess != nullptr && m_pCoreProcess->isStarted()) {
+    qInfo("retrying license activation while core is running");
+    m_optimisticStart = true;
+    activate();
+  } else {
+    activateSpeculatively();
+  }
+}
+
+void LicenseHandler::resumeCoreProcess()
+{
+  if (m_pCoreProcess == nullptr) {
+    qFatal("core process not set");
+  }
+
+  if (m_pCoreProcess->mode() == CoreProcess::Mode::None) {
+    qDebug("no core mode selected, not resuming core process after activation");
+    return;
+  }
+
+  if (m_pCoreProcess->isStarted()) {
+    qDebug("core process already started, not resuming after activation");
+    return;
+  }
+
+  qDebug("resuming core process after activation");
+  QElapsedTimer timer;
+  timer.start();
+  m_pCoreProcess->start();
+  m_activationTrace.coreStart = elapsedMicros(timer);
+}
+
+void LicenseHandler::handleActivationFailed(const QString &message)
+{
+  QString fullMessage = QString(
+                            "<p>There was a problem activating your license.</p>"
+                            "%3"
+                            R"(<p>Please <a href="%1" style="color: %2">contact us</a> )"
+                            "if there is anything we can do to help.</p>"
+  )
+                            .arg(kUrlContact)
+                            .arg(kColorSecondary)
+                            .arg(message);
+
+  // The dialog is modal and would cover the notice, so only show it once that's closed.
+  qWarning("activation failed, showing serial key dialog after notice");
+  m_notifier.post(kActivationNotice, LicenseNotifier::Level::kWarning, "Activation failed", fullMessage, [this] {
+    showSerialKeyDialog();
+  });
+}
+
+void LicenseHandler::startRemoteChecks()
+{
+  if (m_license.productEdition() != Product::Edition::kBusiness) {
+    // Personal licenses are not re-checked, but this still clears any stale grace period.
+    runRemoteCheck();
+    return;
+  }
+
+  const auto configured = m_settings.checkIntervalSecs();
+  const auto interval = configured > 0 ? seconds{configured} : duration_cast<seconds>(kLicenseCheckInterval);
+  qDebug("scheduling remote license checks every %lld seconds", static_cast<long long>(interval.count()));
+  m_checkScheduler.start(machineSignature(), interval, m_settings.lastCheckEpochSecs());
+}
+
+void LicenseHandler::startLicenseRelay()
+{
+  if (m_relay != nullptr || !m_pAppConfig->serverGroupChecked() || !LicenseRelay::isEnabled(m_settings.relayEnabled())) {
+    return;
+  }
+
+  // The relay only passes on answers with a lease, so without a key it can't answer.
+  if (leasePublicKey().isEmpty()) {
+    qWarning("license relay needs a lease public key, not starting relay");
+    return;
+  }
+
+  // Relayed checks go through the same client as this machine's own checks.
+  m_relay = new LicenseRelay(
+      [this](const LicenseApiClient::Data &data) {
+        return m_apiClient != nullptr ? m_apiClient->check(data) : canceledRequest();
+      },
+      this
+  );
+  if (!m_relay->listen(LicenseRelay::listenAddress(m_settings.relayAddress()), kLicenseRelayPort)) {
+    qWarning("license relay not available, clients must check licenses directly");
+  }
+}
+
+void LicenseHandler::startSeatUsageReports()
+{
+  if (m_seatReporter != nullptr || m_license.productEdition() != Product::Edition::kBusiness ||
+      !m_pAppConfig->serverGroupChecked()) {
+    return;
+  }
+
+  // Clients connect to the server, so only the server sees how many seats are in use.
+  m_seatReporter = new SeatUsageReporter(
+      [this](const QCborArray &heartbeats) {
+        return m_apiClient != nullptr ? m_apiClient->heartbeat(buildApiData(), heartbeats) : canceledRequest();
+      },
+      SeatUsageReporter::defaultBufferPath(), m_license.serialKey().seats, this
+  );
+  connect(m_pCoreProcess, &CoreProcess::logLine, m_seatReporter, &SeatUsageReporter::handleLogLine);
+  connect(m_pCoreProcess, &CoreProcess::processStateChanged, m_seatReporter, &SeatUsageReporter::reset);
+  m_seatReporter->start();
+}
+
+void LicenseHandler::startStatusServer()
+{
+  const auto name = LicenseStatusServer::socketName(m_settings.statusSocket());
+  if (name.isEmpty()) {
+    return;
+  }
+
+  // Served by the one process handling the license, so the state is never stale.
+  m_statusServer.start(name);
+}
+
 void LicenseHandler::runRemoteCheck()
 {
   if (!m_settings.activated() || !m_license.isValid() || m_license.serialKey().isOffline) {
@@ -528,35 +1184,226 @@ void LicenseHandler::runRemoteCheck()
       // Nothing else clears grace once personal checks stop, and a stale grace flag
       // suppresses the renew nag forever.
       qInfo("clearing stale grace period for personal license");
-      m_settings.setGraceStartEpochSecs(0);
-      m_settings.sync();
+      LicenseAuditLog::instance().append({.type = LicenseAuditLog::Type::kGraceCleared, .detail = "personal"});
+      m_lifecycle->checkSucceeded();
+      saveLifecycle();
+      syncSettings();
       m_warnedAboutGrace = false;
     }
     qDebug("personal license, skipping remote check");
     return;
   }
 
-  if (m_apiClient.isBusy()) {
-    qDebug("license activator busy, skipping remote check");
+  if (const auto lease = validLease(); lease.has_value()) {
+    qInfo("license lease is valid, skipping remote check");
+    scheduleLeaseRenewal(lease->renewAtSecs());
+    return;
+  }
+
+  sendRemoteCheck();
+}
+
+void LicenseHandler::sendRemoteCheck()
+{
+  if (m_stateChannel.role() == LicenseStateChannel::Role::kSubscriber) {
+    qDebug("license is handled by another process, skipping remote check");
+    return;
+  }
+
+  if (m_apiClient == nullptr) {
+    qDebug("license api stopped, skipping remote check");
+    return;
+  }
+
+  // Other requests, such as seat heartbeats, can share the client; only a second check
+  // would be redundant, and that one's result is still to come.
+  if (m_checkInFlight) {
+    qDebug("remote license check already in flight, skipping");
     return;
   }
 
   qInfo("running remote license check");
-  m_apiClient.check(buildApiData());
+  using Kind = LicenseCoordinator::Kind;
+
+  const auto data = buildApiData();
+
+  // Relay answers are only trusted with a lease, so without a key to verify one the relay
+  // could never help; go straight to the API.
+  const auto relayUrl = leasePublicKey().isEmpty() ? QString() : LicenseRelay::relayUrl(m_settings.relayUrl());
+  const auto request = [this, data, relayUrl] {
+    if (m_apiClient == nullptr) {
+      return canceledRequest();
+    }
+    if (relayUrl.isEmpty()) {
+      return m_apiClient->check(data);
+    }
+
+    qDebug().noquote() << "checking license via relay:" << relayUrl;
+    auto promise = std::make_shared<QPromise<LicenseApiClient::Result>>();
+    promise->start();
+    m_apiClient->check(data, QUrl(relayUrl)).then(this, [this, data, promise](const LicenseApiClient::Result &result) {
+      // The relay is unauthenticated, so anything but a lease for this machine could be
+      // spoofed. It may also just be down, which says nothing about the license, so ask
+      // the API directly rather than start the grace period.
+      using enum LicenseApiClient::Result::Status;
+      if (result.status == kCanceled || (result.isSuccess() && validLease(result.lease).has_value())) {
+        promise->addResult(result);
+        promise->finish();
+        return;
+      }
+
+      qWarning("license relay answer could not be verified, checking directly");
+      const auto direct = m_apiClient != nullptr ? m_apiClient->check(data) : canceledRequest();
+      direct.then(this, [promise](const LicenseApiClient::Result &directResult) {
+        promise->addResult(directResult);
+        promise->finish();
+      });
+    });
+    return promise->future();
+  };
+
+  LicenseMetrics::instance().recordAttempt(LicenseMetrics::Operation::kCheck);
+  m_checkInFlight = true;
+  m_coordinator.run(Kind::kCheck, data.machineSignature, data.serialKey, request)
+      .then(this, [this](const LicenseApiClient::Result &result) {
+        m_checkInFlight = false;
+        handleRemoteCheckResult(result);
+      });
+}
+
+void LicenseHandler::handleRemoteCheckResult(const LicenseApiClient::Result &result)
+{
+  StallWatchdog::Scope scope("LicenseHandler::handleRemoteCheckResult");
+  // Saves the check time along with whatever the result changes, in one write.
+  ExtraSettings::Transaction transaction(m_settings);
+  LicenseMetrics::instance().recordResult(LicenseMetrics::Operation::kCheck, result.status);
+  LicenseAuditLog::instance().append(LicenseAuditLog::resultEvent(
+      LicenseAuditLog::Type::kCheckResult, result.status, result.timings.total(), result.message.toUtf8()
+  ));
+  if (result.status != LicenseApiClient::Result::Status::kCanceled) {
+    m_lastCheckResult = LicenseApiClient::Result::statusName(result.status);
+    m_lastCheckLatencyMs = duration_cast<milliseconds>(result.timings.total()).count();
+    m_settings.setLastCheckEpochSecs(nowSecs());
+    syncSettings();
+  }
+
+  switch (result.status) {
+    using enum LicenseApiClient::Result::Status;
+
+  case kSuccess:
+    handleRemoteCheckSucceeded(result.lease);
+    break;
+
+  case kDisabled:
+    disableLicenseRemotely(result.message);
+    break;
+
+  case kCanceled:
+    qDebug("remote license check canceled");
+    break;
+
+  case kNetworkError:
+    if (validLease().has_value()) {
+      // The current lease still vouches for the license, so there's no need to start the
+      // grace period over a network blip; just try again later.
+      qWarning("lease renewal failed with network error, retrying later");
+      LicenseMetrics::instance().recordRetry(LicenseMetrics::Retry::kLeaseRenewal);
+      const auto retryDelay = duration_cast<seconds>(kLeaseRenewRetryInterval);
+      scheduleLeaseRenewal(nowSecs() + retryDelay.count());
+      break;
+    }
+    handleRemoteCheckFailed(result.message);
+    break;
+
+  default:
+    handleRemoteCheckFailed(result.message);
+  }
+}
+
+std::optional<LicenseLease> LicenseHandler::validLease() const
+{
+  return validLease(m_settings.lease());
+}
+
+std::optional<LicenseLease> LicenseHandler::validLease(const QString &token) const
+{
+  const auto lease = LicenseLease::fromToken(token, leasePublicKey());
+  if (!lease.has_value()) {
+    return std::nullopt;
+  }
+
+  const auto serialKey = serialKeyString();
+  if (!lease->isValidFor(serialKey, machineSignature(), nowSecs())) {
+    qDebug("license lease has expired or is for another key or machine");
+    return std::nullopt;
+  }
+
+  return lease;
+}
+
+void LicenseHandler::storeLease(const QString &token)
+{
+  if (token.isEmpty()) {
+    m_settings.setLease("");
+    return;
+  }
+
+  const auto lease = LicenseLease::fromToken(token, leasePublicKey());
+  const auto serialKey = serialKeyString();
+  if (!lease.has_value() || !lease->isValidFor(serialKey, machineSignature(), nowSecs())) {
+    qWarning("ignoring license lease from server, it could not be verified");
+    m_settings.setLease("");
+    return;
+  }
+
+  qInfo("storing license lease, valid until: %lld", lease->notAfterSecs());
+  m_settings.setLease(token);
+  scheduleLeaseRenewal(lease->renewAtSecs());
 }
 
-void LicenseHandler::handleRemoteCheckSucceeded()
+void LicenseHandler::scheduleLeaseRenewal(qint64 renewAtSecs)
+{
+  const auto delay = seconds{std::max<qint64>(0, renewAtSecs - nowSecs())};
+  const auto interval = duration_cast<milliseconds>(delay);
+  if (interval.count() >= INT_MAX) {
+    qDebug("license lease renewal too distant to schedule timer");
+    return;
+  }
+
+  qDebug("scheduling license lease renewal in %lld seconds", static_cast<long long>(delay.count()));
+  m_leaseRenewTimer.setSingleShot(true);
+  m_leaseRenewTimer.start(interval);
+}
+
+void LicenseHandler::renewLease()
+{
+  if (!m_settings.activated() || !m_license.isValid() || m_license.serialKey().isOffline) {
+    qDebug("license not activated or offline, skipping lease renewal");
+    return;
+  }
+
+  qInfo("renewing license lease");
+  sendRemoteCheck();
+}
+
+void LicenseHandler::handleRemoteCheckSucceeded(const QString &lease)
 {
   qInfo("remote license check succeeded");
 
   const bool wasInGrace = isInGracePeriod();
-  m_settings.setGraceStartEpochSecs(0);
-  m_settings.sync();
+  if (m_lifecycle.has_value()) {
+    m_lifecycle->checkSucceeded();
+  }
+  saveLifecycle();
+  storeLease(lease);
+  syncSettings();
   m_warnedAboutGrace = false;
 
-  if (wasInGrace && m_pMainWindow != nullptr) {
-    QMessageBox::information(
-        m_pMainWindow, "License restored", tr("Your license is valid again. Thanks for your patience.")
+  if (wasInGrace) {
+    LicenseAuditLog::instance().append({.type = LicenseAuditLog::Type::kGraceCleared, .detail = "check"});
+    m_notifier.post(
+        kLicenseStatusNotice, LicenseNotifier::Level::kInformation, "License restored",
+        tr("Your license is valid again. Thanks for your patience.")
     );
   }
 }
@@ -565,21 +1412,30 @@ void LicenseHandler::handleRemoteCheckFailed(const QString &message)
 {
   qWarning().noquote() << "remote license check failed:" << message;
 
-  if (!isInGracePeriod()) {
-    m_settings.setGraceStartEpochSecs(QDateTime::currentSecsSinceEpoch());
-    m_settings.sync();
+  if (!m_lifecycle.has_value()) {
+    return;
   }
 
-  if (isGracePeriodExpired()) {
+  const auto wasInGrace = isInGracePeriod();
+  const auto disabled = m_lifecycle->checkFailed();
+  if (!wasInGrace) {
+    saveLifecycle();
+    syncSettings();
+    LicenseAuditLog::instance().append(
+        {.type = LicenseAuditLog::Type::kGraceStarted, .value = m_settings.graceStartEpochSecs()}
+    );
+  }
+
+  if (disabled) {
     disableLicenseRemotely(message);
     return;
   }
 
-  if (!m_warnedAboutGrace && m_pMainWindow != nullptr) {
+  if (!m_warnedAboutGrace) {
     m_warnedAboutGrace = true;
     const auto graceDays = static_cast<int>(kLicenseGracePeriod.count());
-    QMessageBox::warning(
-        m_pMainWindow, "License check failed",
+    m_notifier.post(
+        kLicenseStatusNotice, LicenseNotifier::Level::kWarning, "License check failed",
         tr("<p>We could not verify your license:</p>"
            "<p><i>%1</i></p>"
            "<p>%2 will keep working for %3 days. "
@@ -597,6 +1453,8 @@ void LicenseHandler::handleRemoteCheckFailed(const QString &message)
 void LicenseHandler::disableLicenseRemotely(const QString &reason)
 {
   qWarning().noquote() << "license grace period expired, disabling:" << reason;
+  const auto detail = reason.toUtf8();
+  LicenseAuditLog::instance().append({.type = LicenseAuditLog::Type::kRemoteDisable, .detail = detail});
 
   if (m_pCoreProcess != nullptr && m_pCoreProcess->isStarted()) {
     qDebug("stopping core process due to disabled license");
@@ -605,21 +1463,110 @@ void LicenseHandler::disableLicenseRemotely(const QString &reason)
 
   // Keep the serial key + in-memory license so the next activation attempt can succeed
   // automatically if the server re-enables the license (e.g. after the customer pays).
-  m_settings.setActivated(false);
-  m_settings.setGraceStartEpochSecs(0);
-  m_settings.sync();
+  if (m_lifecycle.has_value()) {
+    m_lifecycle->disable();
+  }
+  saveLifecycle();
+  m_settings.setLease("");
+  syncSettings();
+  m_leaseRenewTimer.stop();
   m_warnedAboutGrace = false;
 
-  if (m_pMainWindow != nullptr) {
-    QMessageBox::warning(
-        m_pMainWindow, "License disabled",
-        tr("<p>Your license has been disabled and could not be verified within the grace period:</p>"
-           "<p><i>%1</i></p>"
-           R"(<p>Please <a href="%2" style="color: %3">contact us</a> to restore access. )"
-           "Once your license is reinstated, the app will resume automatically.</p>")
-            .arg(reason.toHtmlEscaped())
-            .arg(kUrlContact)
-            .arg(kColorSecondary)
-    );
+  m_notifier.post(
+      kLicenseStatusNotice, LicenseNotifier::Level::kWarning, "License disabled",
+      tr("<p>Your license has been disabled and could not be verified within the grace period:</p>"
+         "<p><i>%1</i></p>"
+         R"(<p>Please <a href="%2" style="color: %3">contact us</a> to restore access. )"
+         "Once your license is reinstated, the app will resume automatically.</p>")
+          .arg(reason.toHtmlEscaped())
+          .arg(kUrlContact)
+          .arg(kColorSecondary)
+  );
+}
+
+void LicenseHandler::syncSettings()
+{
+  m_settings.requestSync();
+  publishState();
+}
+
+void LicenseHandler::publishState()
+{
+  LicenseMetrics::instance().setGraceStart(m_settings.graceStartEpochSecs());
+  m_stateChannel.publish(
+      {LicenseLease::serialHash(m_settings.serialKey()), m_settings.activated(), m_settings.lease(),
+       m_settings.graceStartEpochSecs(), m_settings.lastCheckEpochSecs()}
+  );
+
+  LicenseStatusServer::Status status;
+  status.edition = QString::fromStdString(m_license.productName());
+  status.valid = m_license.isValid() && !m_license.isExpired();
+  if (m_license.isTimeLimited()) {
+    status.daysLeft = static_cast<qint64>(m_license.daysLeft().count());
+  }
+  status.activated = m_settings.activated();
+  status.graceStartEpochSecs = m_settings.graceStartEpochSecs();
+  status.lastCheckEpochSecs = m_settings.lastCheckEpochSecs();
+  status.lastCheckResult = m_lastCheckResult;
+  status.lastCheckLatencyMs = m_lastCheckLatencyMs;
+  status.updatedEpochSecs = nowSecs();
+  m_statusServer.publish(status);
+}
+
+void LicenseHandler::applySharedState(const LicenseStateChannel::State &state)
+{
+  StallWatchdog::Scope scope("LicenseHandler::applySharedState");
+  qDebug("applying license state from host process");
+
+  // Only the hash is sent; the host has already saved the key to the shared system
+  // settings, so that's where a new key is read from.
+  if (state.serialHash != LicenseLease::serialHash(m_settings.serialKey())) {
+    qDebug("license host has a new serial key, reloading settings");
+    m_settings.load();
+    if (state.serialHash != LicenseLease::serialHash(m_settings.serialKey())) {
+      qWarning("license state from host is for a serial key not in settings, ignoring");
+      return;
+    }
+
+    const auto result = setLicense(m_settings.serialKey(), true);
+    if (result != SetSerialKeyResult::kSuccess && result != SetSerialKeyResult::kUnchanged) {
+      qWarning("serial key from license host is not valid, ignoring its state");
+      return;
+    }
+    updateWindowTitle();
+    clampFeatures();
+  }
+
+  // A process that took the socket name could claim anything, but can't sign a lease.
+  // Builds without a lease key have nothing to check against, only the socket's access.
+  const auto activated = state.activated && (leasePublicKey().isEmpty() || validLease(state.lease).has_value());
+  if (state.activated && !activated) {
+    qWarning("license host sent activation without a valid lease, ignoring activation");
+  }
+
+  // Nor can a host prove a deactivation, and any user on the machine may be the host, so
+  // a lease this process holds stands until it runs out.
+  if (!activated && m_settings.activated() && validLease().has_value()) {
+    qWarning("license host sent deactivation while lease is still valid, ignoring it");
+    return;
+  }
+
+  const auto wasActivated = m_settings.activated();
+  if (m_lifecycle.has_value()) {
+    m_lifecycle->restore(activated, graceStartFromSecs(state.graceStartEpochSecs));
+    saveLifecycle();
+  } else {
+    m_settings.setActivated(activated);
+    m_settings.setGraceStartEpochSecs(state.graceStartEpochSecs);
+  }
+  m_settings.setLease(state.lease);
+  m_settings.setLastCheckEpochSecs(state.lastCheckEpochSecs);
+  m_settings.markSaved();
+
+  if (!wasActivated && activated) {
+    resumeCoreProcess();
+  } else if (wasActivated && !activated && m_pCoreProcess != nullptr && m_pCoreProcess->isStarted()) {
+    qWarning("license was deactivated by host process, stopping core");
+    m_pCoreProcess->stop();
   }
 }
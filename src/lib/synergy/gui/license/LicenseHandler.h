@@ -19,10 +19,28 @@
 
 #include "synergy/gui/AppTime.h"
 #include "synergy/gui/ExtraSettings.h"
+#include "synergy/gui/license/ActivationTrace.h"
 #include "synergy/gui/license/LicenseApiClient.h"
+#include "synergy/gui/license/LicenseCheckScheduler.h"
+#include "synergy/gui/license/LicenseCoordinator.h"
+#include "synergy/gui/license/LicenseLease.h"
+#include "synergy/gui/license/LicenseNotifier.h"
+#include "synergy/gui/license/LicenseRelay.h"
+#include "synergy/gui/license/LicenseStateChannel.h"
+#include "synergy/gui/license/LicenseStatusServer.h"
+#include "synergy/gui/license/MachineFingerprint.h"
+#include "synergy/gui/license/SeatUsageReporter.h"
 #include "synergy/license/License.h"
+#include "synergy/license/LicenseLifecycle.h"
 #include "synergy/license/Product.h"
 
+#include <QElapsedTimer>
+#include <QFuture>
+#include <QThread>
+#include <QTimer>
+
+#include <optional>
+
 class AppConfig;
 class QMainWindow;
 class QDialog;
@@ -43,6 +61,18 @@ class LicenseHandler : public QObject
   using License = synergy::license::License;
   using SerialKey = synergy::license::SerialKey;
 
+  struct SpeculativeResult
+  {
+    QString serialKey;
+    synergy::gui::license::LicenseApiClient::Result result;
+  };
+
+  struct SettingsLoad
+  {
+    synergy::gui::ExtraSettings::Snapshot snapshot;
+    std::chrono::microseconds time{0};
+  };
+
 public:
   enum class SetSerialKeyResult
   {
@@ -54,6 +84,7 @@ public:
   };
 
   explicit LicenseHandler();
+  ~LicenseHandler() override;
 
   static LicenseHandler &instance()
   {
@@ -66,13 +97,13 @@ public:
   void handleSettings(
       QDialog *parent, QCheckBox *enableTls, QCheckBox *invertConnection, QRadioButton *systemScope,
       QRadioButton *userScope
-  ) const;
+  );
   void handleVersionCheck(QString &versionUrl);
   bool handleCoreStart();
   bool loadSettings();
   void saveSettings();
-  const License &license() const;
-  Product::Edition productEdition() const;
+  const License &license();
+  Product::Edition productEdition();
   QString productName() const;
   SetSerialKeyResult setLicense(const QString &hexString, bool allowExpired = false);
   void clampFeatures();
@@ -83,26 +114,101 @@ public:
     return m_enabled;
   }
 
+protected:
+  bool eventFilter(QObject *watched, QEvent *event) override;
+
+signals:
+  void activationTraced(const synergy::gui::license::ActivationTrace &trace);
+
 private:
   void checkTlsCheckBox(QDialog *parent, QCheckBox *checkBoxEnableTls, bool showDialog) const;
   void checkInvertConnectionCheckBox(QDialog *parent, QCheckBox *checkBoxInvertConnection, bool showDialog) const;
   void updateWindowTitle() const;
   bool showSerialKeyDialog();
+  bool startLicensing();
+  void waitForStartup();
+  bool applySettings(bool showDialog);
   bool check();
+  void activate(bool speculative = false);
+  void activateSpeculatively();
+  void handleSpeculativeActivationResult(
+      const QString &serialKey, const synergy::gui::license::LicenseApiClient::Result &result
+  );
+  bool hasSpeculativeResult() const;
+  bool applySpeculativeActivation();
+  void handleActivationResult(const synergy::gui::license::LicenseApiClient::Result &result);
+  void handleActivationSucceeded(const QString &lease);
+  void saveActivation(const QString &lease);
+  void handleActivationFailed(const QString &message);
+  void handleOptimisticActivationError(const QString &message);
+  void retryActivation();
+  void resumeCoreProcess();
+  void finishActivationTrace();
+  void startHostDuties();
+  void startRemoteChecks();
   void runRemoteCheck();
-  void handleRemoteCheckSucceeded();
+  void sendRemoteCheck();
+  void handleRemoteCheckResult(const synergy::gui::license::LicenseApiClient::Result &result);
+  void handleRemoteCheckSucceeded(const QString &lease);
   void handleRemoteCheckFailed(const QString &message);
   bool isInGracePeriod() const;
   bool isGracePeriodExpired() const;
+  qint64 nowSecs() const;
+  void restoreLifecycle();
+  void saveLifecycle();
   void disableLicenseRemotely(const QString &reason);
+  std::optional<synergy::gui::license::LicenseLease> validLease() const;
+  std::optional<synergy::gui::license::LicenseLease> validLease(const QString &token) const;
+  void storeLease(const QString &token);
+  void scheduleLeaseRenewal(qint64 renewAtSecs);
+  void renewLease();
+  QString serialKeyString() const;
+  QString machineSignature() const;
   synergy::gui::license::LicenseApiClient::Data buildApiData() const;
+  void stopApiThread();
+  void startLicenseRelay();
+  void startSeatUsageReports();
+  void startStatusServer();
+  void syncSettings();
+  void publishState();
+  void applySharedState(const synergy::gui::license::LicenseStateChannel::State &state);
 
   bool m_enabled = true;
+  bool m_startupDone = false;
+  QElapsedTimer m_startupTimer;
+  std::chrono::microseconds m_startupBlocking{0};
+  QFuture<SettingsLoad> m_settingsLoad;
+  synergy::gui::license::MachineFingerprint m_fingerprint;
   synergy::gui::AppTime m_time;
   License m_license = License::invalid();
+  // Decides activation, grace and disable for `m_license`; settings keep a copy for next time.
+  std::optional<synergy::license::LicenseLifecycle> m_lifecycle;
   synergy::gui::ExtraSettings m_settings;
-  synergy::gui::license::LicenseApiClient m_apiClient;
+  QThread m_apiThread;
+  synergy::gui::license::LicenseApiClient *m_apiClient = nullptr;
+  QTimer m_leaseRenewTimer;
+  synergy::gui::license::LicenseCheckScheduler m_checkScheduler;
+  synergy::gui::license::LicenseCoordinator m_coordinator;
+  synergy::gui::license::LicenseStateChannel m_stateChannel;
+  synergy::gui::license::LicenseRelay *m_relay = nullptr;
+  synergy::gui::license::SeatUsageReporter *m_seatReporter = nullptr;
+  synergy::gui::license::LicenseStatusServer m_statusServer;
+  QString m_lastCheckResult;
+  qint64 m_lastCheckLatencyMs = 0;
+  synergy::gui::license::LicenseNotifier m_notifier;
   bool m_warnedAboutGrace = false;
+  bool m_optimisticStart = false;
+  bool m_appStarted = false;
+  bool m_activationInFlight = false;
+  bool m_checkInFlight = false;
+  bool m_activationSpeculative = false;
+  QTimer m_activationRetryTimer;
+  int m_activationFailures = 0;
+  QString m_activationSerialKey;
+  std::optional<SpeculativeResult> m_speculativeResult;
+  std::chrono::microseconds m_settingsLoadTime{0};
+  QElapsedTimer m_activationTimer;
+  synergy::gui::license::ActivationTrace m_activationTrace;
   QMainWindow *m_pMainWindow = nullptr;
   AppConfig *m_pAppConfig = nullptr;
   deskflow::gui::CoreProcess *m_pCoreProcess = nullptr;
@@ -0,0 +1,133 @@
+/*
+ * Synergy -- mouse and keyboard sharing utility
+ * Copyright (C) 2026 Symless Ltd.
+ *
+ * This package is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * found in the file LICENSE that should have accompanied this file.
+ *
+ * This package is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "LicenseLease.h"
+
+#include <QCryptographicHash>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QtCore>
+
+#include <memory>
+#include <openssl/evp.h>
+
+namespace synergy::gui::license {
+
+#ifdef SYNERGY_LEASE_PUBLIC_KEY
+const auto kLeasePublicKey = SYNERGY_LEASE_PUBLIC_KEY;
+#else
+const auto kLeasePublicKey = "";
+#endif // SYNERGY_LEASE_PUBLIC_KEY
+
+const auto kBase64Options = QByteArray::Base64UrlEncoding | QByteArray::OmitTrailingEquals;
+
+bool verifySignature(const QByteArray &payload, const QByteArray &signature, const QByteArray &publicKey)
+{
+  const auto kKeySize = 32;
+  const auto kSignatureSize = 64;
+  if (publicKey.size() != kKeySize || signature.size() != kSignatureSize) {
+    return false;
+  }
+
+  const auto key = std::unique_ptr<EVP_PKEY, decltype(&EVP_PKEY_free)>(
+      EVP_PKEY_new_raw_public_key(
+          EVP_PKEY_ED25519, nullptr, reinterpret_cast<const unsigned char *>(publicKey.constData()), publicKey.size()
+      ),
+      &EVP_PKEY_free
+  );
+  if (!key) {
+    qWarning("failed to load lease public key");
+    return false;
+  }
+
+  const auto context = std::unique_ptr<EVP_MD_CTX, decltype(&EVP_MD_CTX_free)>(EVP_MD_CTX_new(), &EVP_MD_CTX_free);
+  if (!context || EVP_DigestVerifyInit(context.get(), nullptr, nullptr, nullptr, key.get()) != 1) {
+    qWarning("failed to init lease signature check");
+    return false;
+  }
+
+  return EVP_DigestVerify(
+             context.get(), reinterpret_cast<const unsigned char *>(signature.constData()), signature.size(),
+             reinterpret_cast<const unsigned char *>(payload.constData()), payload.size()
+         ) == 1;
+}
+
+std::optional<LicenseLease> LicenseLease::fromToken(const QString &token, const QByteArray &publicKey)
+{
+  if (token.isEmpty() || publicKey.isEmpty()) {
+    return std::nullopt;
+  }
+
+  const auto parts = token.toLatin1().split('.');
+  if (parts.size() != 2) {
+    qWarning("malformed license lease");
+    return std::nullopt;
+  }
+
+  const auto &encodedPayload = parts.at(0);
+  const auto signature = QByteArray::fromBase64(parts.at(1), kBase64Options);
+  if (!verifySignature(encodedPayload, signature, publicKey)) {
+    qWarning("license lease signature is not valid");
+    return std::nullopt;
+  }
+
+  const auto payload = QJsonDocument::fromJson(QByteArray::fromBase64(encodedPayload, kBase64Options)).object();
+
+  LicenseLease lease;
+  lease.m_token = token;
+  lease.m_serialHash = payload["serialHash"].toString();
+  lease.m_machineSignature = payload["machineSignature"].toString();
+  lease.m_issuedAtSecs = payload["issuedAt"].toInteger();
+  lease.m_notAfterSecs = payload["notAfter"].toInteger();
+
+  if (lease.m_serialHash.isEmpty() || lease.m_machineSignature.isEmpty() || lease.m_notAfterSecs <= 0) {
+    qWarning("license lease payload is incomplete");
+    return std::nullopt;
+  }
+
+  return lease;
+}
+
+QString LicenseLease::serialHash(const QString &serialKey)
+{
+  return QCryptographicHash::hash(serialKey.toUtf8(), QCryptographicHash::Sha256).toHex();
+}
+
+bool LicenseLease::isValidFor(const QString &serialKey, const QString &machineSignature, qint64 nowSecs) const
+{
+  return m_serialHash == serialHash(serialKey) && m_machineSignature == machineSignature && nowSecs < m_notAfterSecs;
+}
+
+qint64 LicenseLease::renewAtSecs() const
+{
+  // Renew with a quarter of the lease left, so there's time to retry if the network is down.
+  const auto lifetime = m_notAfterSecs - m_issuedAtSecs;
+  return m_issuedAtSecs + (lifetime * 3 / 4);
+}
+
+QByteArray leasePublicKey()
+{
+#ifndef NDEBUG
+  // Only for tests; in release builds anyone who set this could sign their own leases.
+  if (const auto envVar = qEnvironmentVariable("SYNERGY_TEST_LEASE_PUBLIC_KEY"); !envVar.isEmpty()) {
+    return QByteArray::fromBase64(envVar.toLatin1());
+  }
+#endif // NDEBUG
+  return QByteArray::fromBase64(kLeasePublicKey);
+}
+
+} // namespace synergy::gui::license
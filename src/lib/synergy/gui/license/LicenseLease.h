@@ -0,0 +1,77 @@
+/*
+ * Synergy -- mouse and keyboard sharing utility
+ * Copyright (C) 2026 Symless Ltd.
+ *
+ * This package is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * found in the file LICENSE that should have accompanied this file.
+ *
+ * This package is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <QByteArray>
+#include <QString>
+
+#include <optional>
+
+namespace synergy::gui::license {
+
+/**
+ * @brief A signed, time-limited statement from the license server that a serial key
+ * is good on a particular machine.
+ *
+ * The token is `<payload>.<signature>`, both base64url encoded. The payload is a JSON
+ * object with `serialHash`, `machineSignature`, `issuedAt` and `notAfter` (seconds
+ * since epoch), and the signature is Ed25519 over the encoded payload bytes.
+ */
+class LicenseLease
+{
+public:
+  static std::optional<LicenseLease> fromToken(const QString &token, const QByteArray &publicKey);
+  static QString serialHash(const QString &serialKey);
+
+  bool isValidFor(const QString &serialKey, const QString &machineSignature, qint64 nowSecs) const;
+  qint64 renewAtSecs() const;
+
+  const QString &token() const
+  {
+    return m_token;
+  }
+
+  qint64 issuedAtSecs() const
+  {
+    return m_issuedAtSecs;
+  }
+
+  qint64 notAfterSecs() const
+  {
+    return m_notAfterSecs;
+  }
+
+private:
+  LicenseLease() = default;
+
+  QString m_token;
+  QString m_serialHash;
+  QString m_machineSignature;
+  qint64 m_issuedAtSecs = 0;
+  qint64 m_notAfterSecs = 0;
+};
+
+/**
+ * @brief The raw Ed25519 public key that leases are verified against.
+ *
+ * Empty if no key was configured at build time, in which case leases are ignored.
+ * Debug builds can use another key for tests, set by `SYNERGY_TEST_LEASE_PUBLIC_KEY`.
+ */
+QByteArray leasePublicKey();
+
+} // namespace synergy::gui::license
@@ -0,0 +1,218 @@
+/*
+ * Synergy -- mouse and keyboard sharing utility
+ * Copyright (C) 2026 Symless Ltd.
+ *
+ * This package is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * found in the file LICENSE that should have accompanied this file.
+ *
+ * This package is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "LicenseMetrics.h"
+
+#include "synergy/gui/constants.h"
+
+#include <QCoreApplication>
+#include <QSaveFile>
+#include <QTimer>
+#include <QtCore>
+
+using namespace std::chrono;
+
+namespace synergy::gui::license {
+
+namespace {
+
+const std::array kOperationNames = {"activation", "check"};
+const std::array kEndpointNames = {"activate", "check", "heartbeat"};
+const std::array kRetryNames = {"activation", "lease_renewal", "seat_heartbeats"};
+
+std::vector<microseconds> apiLatencyBounds()
+{
+  return {50ms, 100ms, 250ms, 500ms, 1s, 2500ms, 5s, 10s, 30s};
+}
+
+std::vector<microseconds> settingsSyncBounds()
+{
+  return {100us, 1ms, 5ms, 10ms, 50ms, 100ms, 500ms, 1s};
+}
+
+const char *statusName(std::size_t status)
+{
+  return LicenseApiClient::Result::statusName(static_cast<LicenseMetrics::Status>(status));
+}
+
+template <typename Enum> std::size_t index(Enum value)
+{
+  return static_cast<std::size_t>(value);
+}
+
+QString label(const char *name, const char *value)
+{
+  return QString(R"(%1="%2")").arg(QLatin1StringView(name), QLatin1StringView(value));
+}
+
+QString labels(const char *name1, const char *value1, const char *name2, const char *value2)
+{
+  return QString("%1,%2").arg(label(name1, value1), label(name2, value2));
+}
+
+} // namespace
+
+LicenseMetrics &LicenseMetrics::instance()
+{
+  static LicenseMetrics metrics;
+  return metrics;
+}
+
+void LicenseMetrics::startForApp()
+{
+  static auto started = false;
+  if (started || QCoreApplication::instance() == nullptr) {
+    return;
+  }
+  started = true;
+
+  const auto path = qEnvironmentVariable("SYNERGY_METRICS_FILE");
+  if (path.isEmpty()) {
+    return;
+  }
+
+  qInfo().noquote() << "writing license metrics to:" << path;
+  const auto app = QCoreApplication::instance();
+  const auto write = [path] { instance().writeFile(path); };
+  const auto timer = new QTimer(app);
+  QObject::connect(timer, &QTimer::timeout, app, write);
+  QObject::connect(app, &QCoreApplication::aboutToQuit, app, write);
+  timer->start(kMetricsWriteInterval);
+}
+
+LicenseMetrics::LicenseMetrics()
+    : m_apiLatency{
+          metrics::Histogram(apiLatencyBounds()), metrics::Histogram(apiLatencyBounds()),
+          metrics::Histogram(apiLatencyBounds())
+      },
+      m_settingsSync(settingsSyncBounds())
+{
+}
+
+void LicenseMetrics::recordAttempt(Operation operation)
+{
+  m_attempts[index(operation)].add();
+}
+
+void LicenseMetrics::recordResult(Operation operation, Status status)
+{
+  m_results[index(operation)][index(status)].add();
+}
+
+void LicenseMetrics::recordRetry(Retry retry)
+{
+  m_retries[index(retry)].add();
+}
+
+void LicenseMetrics::recordApiRequest(Endpoint endpoint, Status status, microseconds latency)
+{
+  m_apiRequests[index(endpoint)][index(status)].add();
+  m_apiLatency[index(endpoint)].observe(latency);
+}
+
+void LicenseMetrics::recordSettingsSync(microseconds duration)
+{
+  m_settingsSync.observe(duration);
+}
+
+void LicenseMetrics::setGraceStart(qint64 epochSecs)
+{
+  m_graceStart.set(epochSecs);
+}
+
+QString LicenseMetrics::prometheusText(qint64 nowSecs) const
+{
+  using namespace metrics;
+  QString out;
+
+  writeHeader(out, "synergy_license_attempts_total", "counter", "License activations and checks attempted.");
+  for (std::size_t op = 0; op < kOperations; op++) {
+    const auto value = static_cast<double>(m_attempts[op].value());
+    writeSample(out, "synergy_license_attempts_total", label("operation", kOperationNames[op]), value);
+  }
+
+  writeHeader(out, "synergy_license_results_total", "counter", "License activation and check results.");
+  for (std::size_t op = 0; op < kOperations; op++) {
+    for (std::size_t status = 0; status < kStatuses; status++) {
+      const auto value = static_cast<double>(m_results[op][status].value());
+      writeSample(
+          out, "synergy_license_results_total",
+          labels("operation", kOperationNames[op], "result", statusName(status)), value
+      );
+    }
+  }
+
+  writeHeader(out, "synergy_license_retries_total", "counter", "License operations retried.");
+  for (std::size_t retry = 0; retry < kRetries; retry++) {
+    const auto value = static_cast<double>(m_retries[retry].value());
+    writeSample(out, "synergy_license_retries_total", label("reason", kRetryNames[retry]), value);
+  }
+
+  writeHeader(out, "synergy_license_api_requests_total", "counter", "License API requests by endpoint and status.");
+  for (std::size_t endpoint = 0; endpoint < kEndpoints; endpoint++) {
+    for (std::size_t status = 0; status < kStatuses; status++) {
+      const auto value = static_cast<double>(m_apiRequests[endpoint][status].value());
+      writeSample(
+          out, "synergy_license_api_requests_total",
+          labels("endpoint", kEndpointNames[endpoint], "status", statusName(status)), value
+      );
+    }
+  }
+
+  writeHeader(
+      out, "synergy_license_api_latency_seconds", "histogram", "License API request time, from queued to finished."
+  );
+  for (std::size_t endpoint = 0; endpoint < kEndpoints; endpoint++) {
+    const auto endpointLabel = label("endpoint", kEndpointNames[endpoint]);
+    m_apiLatency[endpoint].write(out, "synergy_license_api_latency_seconds", endpointLabel);
+  }
+
+  writeHeader(out, "synergy_license_settings_sync_seconds", "histogram", "Time taken to save license settings.");
+  m_settingsSync.write(out, "synergy_license_settings_sync_seconds");
+
+  const auto graceStart = m_graceStart.value();
+  writeHeader(
+      out, "synergy_license_grace_start_timestamp_seconds", "gauge",
+      "When the license grace period started, or zero if not in one."
+  );
+  writeSample(out, "synergy_license_grace_start_timestamp_seconds", {}, static_cast<double>(graceStart));
+
+  writeHeader(out, "synergy_license_grace_seconds", "gauge", "Time spent in the license grace period so far.");
+  const auto graceSecs = graceStart > 0 ? nowSecs - graceStart : 0;
+  writeSample(out, "synergy_license_grace_seconds", {}, static_cast<double>(graceSecs));
+
+  return out;
+}
+
+bool LicenseMetrics::writeFile(const QString &path) const
+{
+  // Replaced in one go, so a collector never reads a half-written file.
+  QSaveFile file(path);
+  if (!file.open(QIODevice::WriteOnly)) {
+    qWarning().noquote() << "unable to write license metrics:" << path << file.errorString();
+    return false;
+  }
+
+  file.write(prometheusText(QDateTime::currentSecsSinceEpoch()).toUtf8());
+  if (!file.commit()) {
+    qWarning().noquote() << "unable to save license metrics:" << path << file.errorString();
+    return false;
+  }
+  return true;
+}
+
+} // namespace synergy::gui::license
@@ -0,0 +1,103 @@
+/*
+ * Synergy -- mouse and keyboard sharing utility
+ * Copyright (C) 2026 Symless Ltd.
+ *
+ * This package is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * found in the file LICENSE that should have accompanied this file.
+ *
+ * This package is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include "synergy/gui/license/LicenseApiClient.h"
+#include "synergy/gui/metrics.h"
+
+#include <QString>
+
+#include <array>
+#include <chrono>
+
+namespace synergy::gui::license {
+
+/**
+ * @brief Counters and latencies for licensing, so fleet monitoring can spot the license
+ * service degrading before users do.
+ *
+ * Set `SYNERGY_METRICS_FILE` and they're written there in the Prometheus text format
+ * periodically and on quit, replacing the file each time so it suits the node exporter
+ * textfile collector.
+ */
+class LicenseMetrics
+{
+public:
+  enum class Operation
+  {
+    kActivation,
+    kCheck
+  };
+
+  enum class Endpoint
+  {
+    kActivate,
+    kCheck,
+    kHeartbeat
+  };
+
+  enum class Retry
+  {
+    kActivation,
+    kLeaseRenewal,
+    kSeatHeartbeats
+  };
+
+  using Status = LicenseApiClient::Result::Status;
+
+  static LicenseMetrics &instance();
+
+  /**
+   * @brief Starts writing the metrics file if `SYNERGY_METRICS_FILE` is set.
+   *
+   * Must be called once the app exists; later calls do nothing.
+   */
+  static void startForApp();
+
+  LicenseMetrics();
+
+  void recordAttempt(Operation operation);
+  void recordResult(Operation operation, Status status);
+  void recordRetry(Retry retry);
+  void recordApiRequest(Endpoint endpoint, Status status, std::chrono::microseconds latency);
+  void recordSettingsSync(std::chrono::microseconds duration);
+
+  /**
+   * @param epochSecs When the grace period started, or zero if not in one.
+   */
+  void setGraceStart(qint64 epochSecs);
+
+  QString prometheusText(qint64 nowSecs) const;
+  bool writeFile(const QString &path) const;
+
+private:
+  static constexpr std::size_t kOperations = 2;
+  static constexpr std::size_t kEndpoints = 3;
+  static constexpr std::size_t kRetries = 3;
+  static constexpr std::size_t kStatuses = 5;
+
+  std::array<metrics::Counter, kOperations> m_attempts;
+  std::array<std::array<metrics::Counter, kStatuses>, kOperations> m_results;
+  std::array<metrics::Counter, kRetries> m_retries;
+  std::array<std::array<metrics::Counter, kStatuses>, kEndpoints> m_apiRequests;
+  std::array<metrics::Histogram, kEndpoints> m_apiLatency;
+  metrics::Histogram m_settingsSync;
+  metrics::Gauge m_graceStart;
+};
+
+} // namespace synergy::gui::license
@@ -0,0 +1,115 @@
+/*
+ * Synergy -- mouse and keyboard sharing utility
+ * Copyright (C) 2026 Symless Ltd.
+ *
+ * This package is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * found in the file LICENSE that should have accompanied this file.
+ *
+ * This package is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "LicenseNotifier.h"
+
+#include <QMessageBox>
+#include <QTimer>
+#include <QtCore>
+
+#include <algorithm>
+#include <utility>
+
+namespace synergy::gui::license {
+
+LicenseNotifier::LicenseNotifier(QObject *parent) : QObject(parent)
+{
+}
+
+void LicenseNotifier::setParentWidget(QWidget *parent)
+{
+  m_parent = parent;
+}
+
+void LicenseNotifier::post(
+    const QString &key, Level level, const QString &title, const QString &message, std::function<void()> dismissed
+)
+{
+  const auto pending =
+      std::find_if(m_pending.begin(), m_pending.end(), [&key](const Notice &notice) { return notice.key == key; });
+  if (pending != m_pending.end()) {
+    qDebug().noquote() << "coalescing license notice:" << key;
+    pending->level = level;
+    pending->title = title;
+    pending->message = message;
+    pending->dismissed = std::move(dismissed);
+    pending->repeats++;
+  } else {
+    m_pending.append({key, level, title, message, std::move(dismissed)});
+  }
+
+  if (!m_scheduled) {
+    m_scheduled = true;
+    QTimer::singleShot(0, this, &LicenseNotifier::showPending);
+  }
+}
+
+void LicenseNotifier::showPending()
+{
+  m_scheduled = false;
+
+  // Showing a notice doesn't block, but take the queue first in case it posts more.
+  const auto notices = std::exchange(m_pending, {});
+  for (const auto &notice : notices) {
+    show(notice);
+  }
+}
+
+void LicenseNotifier::show(const Notice &notice)
+{
+  if (m_parent.isNull()) {
+    qDebug().noquote() << "no window for license notice, not showing:" << notice.key;
+    if (notice.dismissed) {
+      notice.dismissed();
+    }
+    return;
+  }
+
+  if (notice.dismissed) {
+    m_dismissed.insert(notice.key, notice.dismissed);
+  } else {
+    m_dismissed.remove(notice.key);
+  }
+
+  auto box = m_shown.value(notice.key);
+  if (box.isNull()) {
+    box = new QMessageBox(m_parent);
+    box->setAttribute(Qt::WA_DeleteOnClose);
+    box->setWindowModality(Qt::NonModal);
+    box->setStandardButtons(QMessageBox::Ok);
+    connect(box, &QMessageBox::finished, this, [this, key = notice.key] {
+      if (const auto dismissed = m_dismissed.take(key); dismissed) {
+        dismissed();
+      }
+    });
+    m_shown.insert(notice.key, box);
+  } else {
+    qDebug().noquote() << "updating license notice already shown:" << notice.key;
+  }
+
+  if (notice.repeats > 1) {
+    qDebug().noquote() << "license notice posted" << notice.repeats << "times:" << notice.key;
+  }
+
+  box->setIcon(notice.level == Level::kWarning ? QMessageBox::Warning : QMessageBox::Information);
+  box->setWindowTitle(notice.title);
+  box->setText(notice.message);
+  box->show();
+  box->raise();
+}
+
+} // namespace synergy::gui::license
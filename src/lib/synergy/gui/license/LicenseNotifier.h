@@ -0,0 +1,102 @@
+/*
+ * Synergy -- mouse and keyboard sharing utility
+ * Copyright (C) 2026 Symless Ltd.
+ *
+ * This package is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * found in the file LICENSE that should have accompanied this file.
+ *
+ * This package is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <QHash>
+#include <QList>
+#include <QObject>
+#include <QPointer>
+#include <QString>
+
+#include <functional>
+
+class QMessageBox;
+class QWidget;
+class LicenseNotifierTests;
+
+namespace synergy::gui::license {
+
+/**
+ * @brief Shows license notices without blocking whoever posted them.
+ *
+ * `QMessageBox::warning` and friends spin a nested event loop, so calling them from a
+ * network reply slot lets further replies and core process changes run re-entrantly
+ * under the dialog. Notices posted here are queued, then shown as non-modal message
+ * boxes once control is back in the event loop.
+ *
+ * Notices with the same key replace each other: one still queued is updated, and one
+ * already on screen has its text changed, so repeats never stack up.
+ *
+ * Anything that should follow a notice, such as a modal dialog, goes in its `dismissed`
+ * callback, so the user reads the notice before the next window takes over.
+ */
+class LicenseNotifier : public QObject
+{
+  Q_OBJECT
+  friend class ::LicenseNotifierTests;
+
+public:
+  enum class Level
+  {
+    kInformation,
+    kWarning
+  };
+
+  explicit LicenseNotifier(QObject *parent = nullptr);
+
+  /**
+   * @brief Sets the window that notices are shown over; with none, they're only logged.
+   */
+  void setParentWidget(QWidget *parent);
+
+  /**
+   * @param dismissed Called once the notice is closed, or straight after it would have
+   * been shown if there's no window; a later notice with the same key replaces it.
+   */
+  void post(
+      const QString &key, Level level, const QString &title, const QString &message,
+      std::function<void()> dismissed = {}
+  );
+
+  qsizetype pendingCount() const
+  {
+    return m_pending.size();
+  }
+
+private:
+  struct Notice
+  {
+    QString key;
+    Level level;
+    QString title;
+    QString message;
+    std::function<void()> dismissed;
+    int repeats = 1;
+  };
+
+  void showPending();
+  void show(const Notice &notice);
+
+  QPointer<QWidget> m_parent;
+  QList<Notice> m_pending;
+  QHash<QString, QPointer<QMessageBox>> m_shown;
+  QHash<QString, std::function<void()>> m_dismissed;
+  bool m_scheduled = false;
+};
+
+} // namespace synergy::gui::license
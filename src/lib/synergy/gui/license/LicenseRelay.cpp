@@ -0,0 +1,224 @@
+/*
+ * Synergy -- mouse and keyboard sharing utility
+ * Copyright (C) 2026 Symless Ltd.
+ *
+ * This package is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * found in the file LICENSE that should have accompanied this file.
+ *
+ * This package is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "LicenseRelay.h"
+
+#include "gui/string_utils.h"
+#include "synergy/gui/constants.h"
+#include "synergy/gui/license/LicenseLease.h"
+
+#include <QCborMap>
+#include <QDateTime>
+#include <QTcpSocket>
+#include <QtCore>
+
+#include <algorithm>
+#include <utility>
+
+using namespace std::chrono;
+
+namespace synergy::gui::license {
+
+const auto kCheckPath = "/product/check";
+
+LicenseRelay::LicenseRelay(Upstream upstream, QObject *parent)
+    : QObject(parent),
+      m_upstream(std::move(upstream)),
+      m_http([this](const LocalHttpServer::Request &request, QTcpSocket *socket) { handleRequest(request, socket); })
+{
+  m_flushTimer.setSingleShot(true);
+  m_flushTimer.setInterval(duration_cast<milliseconds>(kLicenseRelayBatchInterval));
+  connect(&m_flushTimer, &QTimer::timeout, this, &LicenseRelay::flush);
+}
+
+bool LicenseRelay::isEnabled(bool configured)
+{
+  const auto envVar = qEnvironmentVariable("SYNERGY_LICENSE_RELAY");
+  return envVar.isEmpty() ? configured : strToTrue(envVar);
+}
+
+QString LicenseRelay::relayUrl(const QString &configured)
+{
+  const auto envVar = qEnvironmentVariable("SYNERGY_LICENSE_RELAY_URL");
+  const auto base = envVar.isEmpty() ? configured : envVar;
+  if (base.isEmpty()) {
+    return {};
+  }
+
+  return QUrl(base).resolved(QUrl(kCheckPath)).toString();
+}
+
+QHostAddress LicenseRelay::listenAddress(const QString &configured)
+{
+  const auto envVar = qEnvironmentVariable("SYNERGY_LICENSE_RELAY_ADDRESS");
+  return QHostAddress(envVar.isEmpty() ? configured : envVar);
+}
+
+void LicenseRelay::setBatchInterval(milliseconds interval)
+{
+  m_flushTimer.setInterval(interval);
+}
+
+bool LicenseRelay::listen(const QHostAddress &address, quint16 port)
+{
+  if (address.isNull()) {
+    qWarning("no license relay address configured, not starting relay");
+    return false;
+  }
+
+  if (!m_http.listen(address, port)) {
+    qWarning().noquote() << "unable to start license relay:" << m_http.errorString();
+    return false;
+  }
+
+  qInfo().noquote() << "license relay listening on:" << address.toString() << m_http.port();
+  return true;
+}
+
+void LicenseRelay::close()
+{
+  m_http.close();
+  m_flushTimer.stop();
+  m_waiting.clear();
+}
+
+bool LicenseRelay::isListening() const
+{
+  return m_http.isListening();
+}
+
+quint16 LicenseRelay::port() const
+{
+  return m_http.port();
+}
+
+void LicenseRelay::handleRequest(const LocalHttpServer::Request &request, QTcpSocket *socket)
+{
+  if (request.method != "POST") {
+    LocalHttpServer::respond(socket, 405, {}, {});
+    return;
+  }
+
+  if (request.path != kCheckPath) {
+    LocalHttpServer::respond(socket, 404, {}, {});
+    return;
+  }
+
+  bool decoded = false;
+  const auto format = responseWireFormat(QString::fromLatin1(request.contentType));
+  const auto message = decodeMessage(request.body, format, &decoded);
+  if (!decoded) {
+    qWarning("license relay got an invalid request");
+    LocalHttpServer::respond(socket, 400, {}, {});
+    return;
+  }
+
+  Waiter waiter{
+      socket,
+      {message.value(QStringLiteral("machineSignature")).toString(),
+       message.value(QStringLiteral("hostnameSignature")).toString(),
+       message.value(QStringLiteral("serialKey")).toString(), message.value(QStringLiteral("appVersion")).toString(),
+       message.value(QStringLiteral("osName")).toString(), message.value(QStringLiteral("isServer")).toBool()},
+      format
+  };
+
+  if (waiter.data.serialKey.isEmpty() || waiter.data.machineSignature.isEmpty()) {
+    qWarning("license relay request missing serial key or machine signature");
+    LocalHttpServer::respond(socket, 400, {}, {});
+    return;
+  }
+
+  const auto key = waitKey(waiter.data);
+  const auto cached = m_cache.constFind(key);
+  if (cached != m_cache.cend() && cached->expiresAtSecs > QDateTime::currentSecsSinceEpoch()) {
+    qDebug("license relay answering from cache");
+    answer(waiter, cached->result);
+    return;
+  }
+
+  m_waiting[key].append(waiter);
+  if (!m_flushTimer.isActive()) {
+    m_flushTimer.start();
+  }
+}
+
+void LicenseRelay::flush()
+{
+  const auto waiting = std::exchange(m_waiting, {});
+  for (auto it = waiting.cbegin(); it != waiting.cend(); ++it) {
+    const auto &waiters = it.value();
+    const auto isConnected = [](const Waiter &waiter) { return !waiter.socket.isNull(); };
+    const auto first = std::find_if(waiters.cbegin(), waiters.cend(), isConnected);
+    if (first == waiters.cend()) {
+      continue;
+    }
+
+    // Every waiter has the same key and machine, so any of them can be sent upstream.
+    qInfo("license relay sending one check upstream for %lld requests", static_cast<long long>(waiters.size()));
+    const auto key = it.key();
+    const auto data = first->data;
+    m_upstream(data).then(this, [this, key, data, waiters](const Result &result) {
+      if (isVerifiable(data, result)) {
+        const auto ttl = duration_cast<seconds>(kLicenseRelaySuccessTtl);
+        m_cache.insert(key, {result, QDateTime::currentSecsSinceEpoch() + ttl.count()});
+      }
+
+      for (const auto &waiter : waiters) {
+        answer(waiter, result);
+      }
+    });
+  }
+}
+
+void LicenseRelay::answer(const Waiter &waiter, const Result &result) const
+{
+  if (waiter.socket.isNull()) {
+    return;
+  }
+
+  if (!isVerifiable(waiter.data, result)) {
+    // Clients treat this the same as not reaching the license API themselves.
+    qDebug("license relay has no verifiable answer, telling client to retry");
+    LocalHttpServer::respond(waiter.socket, 502, {}, {});
+    return;
+  }
+
+  QCborMap body;
+  body[QStringLiteral("status")] = QStringLiteral("success");
+  body[QStringLiteral("lease")] = result.lease;
+  LocalHttpServer::respond(waiter.socket, 200, contentType(waiter.format), encodeMessage(body, waiter.format));
+}
+
+bool LicenseRelay::isVerifiable(const Data &data, const Result &result)
+{
+  if (!result.isSuccess()) {
+    return false;
+  }
+
+  const auto lease = LicenseLease::fromToken(result.lease, leasePublicKey());
+  return lease.has_value() &&
+         lease->isValidFor(data.serialKey, data.machineSignature, QDateTime::currentSecsSinceEpoch());
+}
+
+QString LicenseRelay::waitKey(const Data &data)
+{
+  // Leases are bound to a machine, so requests are only shared by the same machine;
+  // each client still costs one upstream check.
+  return LicenseLease::serialHash(data.serialKey) + "/" + data.machineSignature;
+}
+
+} // namespace synergy::gui::license
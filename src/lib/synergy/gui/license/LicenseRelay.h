@@ -0,0 +1,112 @@
+/*
+ * Synergy -- mouse and keyboard sharing utility
+ * Copyright (C) 2026 Symless Ltd.
+ *
+ * This package is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * found in the file LICENSE that should have accompanied this file.
+ *
+ * This package is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include "synergy/gui/license/LicenseApiClient.h"
+#include "synergy/gui/license/LocalHttpServer.h"
+
+#include <QByteArray>
+#include <QFuture>
+#include <QHash>
+#include <QList>
+#include <QObject>
+#include <QPointer>
+#include <QTimer>
+
+#include <chrono>
+#include <functional>
+
+class QTcpSocket;
+
+namespace synergy::gui::license {
+
+/**
+ * @brief Answers license checks from clients on the LAN, so only the server needs internet.
+ *
+ * Clients post the same check request they would send to the license API. Requests are
+ * collected for a short interval, then one upstream check is sent per serial key and
+ * machine, and its answer is given to every request from that machine. Answers are
+ * cached for a while, so repeated client checks never leave the LAN.
+ *
+ * Leases are signed by the license API for one machine, and the relay can't sign them,
+ * so requests from different clients are never merged: the server still sends one
+ * upstream check per client. What the relay saves is each client's own internet access,
+ * and the repeats (retries, restarts) that the cache answers.
+ *
+ * The relay is plain HTTP without authentication, so it only passes on answers that a
+ * client can verify for itself: a success with a lease signed for that client's key and
+ * machine. Anything else (a rejection, a disabled license) is answered as a bad gateway,
+ * and the client treats it like not reaching the license API.
+ */
+class LicenseRelay : public QObject
+{
+  Q_OBJECT
+
+  using Data = LicenseApiClient::Data;
+  using Result = LicenseApiClient::Result;
+
+public:
+  using Upstream = std::function<QFuture<Result>(const Data &)>;
+
+  explicit LicenseRelay(Upstream upstream, QObject *parent = nullptr);
+
+  bool listen(const QHostAddress &address, quint16 port);
+  void close();
+
+  bool isListening() const;
+  quint16 port() const;
+
+  static bool isEnabled(bool configured);
+  static QString relayUrl(const QString &configured);
+
+  /**
+   * @brief The interface to listen on; null if none is configured, as listening on every
+   *    interface would offer the relay to any network the server is on.
+   */
+  static QHostAddress listenAddress(const QString &configured);
+
+  void setBatchInterval(std::chrono::milliseconds interval);
+
+private:
+  struct Waiter
+  {
+    QPointer<QTcpSocket> socket;
+    Data data;
+    WireFormat format;
+  };
+
+  struct CachedResult
+  {
+    Result result;
+    qint64 expiresAtSecs = 0;
+  };
+
+  void handleRequest(const LocalHttpServer::Request &request, QTcpSocket *socket);
+  void flush();
+  void answer(const Waiter &waiter, const Result &result) const;
+  static bool isVerifiable(const Data &data, const Result &result);
+  static QString waitKey(const Data &data);
+
+  Upstream m_upstream;
+  LocalHttpServer m_http;
+  QTimer m_flushTimer;
+  QHash<QString, QList<Waiter>> m_waiting;
+  QHash<QString, CachedResult> m_cache;
+};
+
+} // namespace synergy::gui::license
@@ -0,0 +1,280 @@
+/*
+ * Synergy -- mouse and keyboard sharing utility
+ * Copyright (C) 2026 Symless Ltd.
+ *
+ * This package is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * found in the file LICENSE that should have accompanied this file.
+ *
+ * This package is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "LicenseStateChannel.h"
+
+#include "synergy/gui/license/LicenseLease.h"
+
+#include <QDir>
+#include <QJsonDocument>
+#include <QLocalServer>
+#include <QLocalSocket>
+#include <QStandardPaths>
+#include <QtCore>
+
+namespace synergy::gui::license {
+
+const auto kTypeState = "state";
+const auto kTypeActivate = "activate";
+
+LicenseStateChannel::LicenseStateChannel(QObject *parent) : QObject(parent)
+{
+}
+
+LicenseStateChannel::~LicenseStateChannel()
+{
+  stop();
+}
+
+bool LicenseStateChannel::isMachineWide()
+{
+  // Without a lease key, an activation pushed by the host can't be verified, so only
+  // processes of the same user may share the license.
+  return !leasePublicKey().isEmpty();
+}
+
+QString LicenseStateChannel::serverName()
+{
+#if defined(Q_OS_WIN)
+  // Pipe names are machine-wide, across sessions too.
+  if (isMachineWide()) {
+    return QStringLiteral("synergy-license");
+  }
+  return QStringLiteral("synergy-license-%1").arg(qEnvironmentVariable("USERNAME"));
+#else
+  // Not a bare name, which would go in the temp dir, and that's per user on some systems.
+  if (isMachineWide()) {
+    return QStringLiteral("/tmp/synergy-license");
+  }
+
+  // A full path in the user's runtime dir, which nobody else can create sockets in.
+  const auto dir = QStandardPaths::writableLocation(QStandardPaths::RuntimeLocation);
+  return QDir(dir).filePath("synergy-license");
+#endif
+}
+
+void LicenseStateChannel::start()
+{
+  if (m_role != Role::kNone || m_hostSocket != nullptr) {
+    return;
+  }
+
+  // Connecting can take a while if the host is busy, so don't wait for it; the role is
+  // decided once the connection is made or fails.
+  auto socket = new QLocalSocket(this);
+  m_hostSocket = socket;
+  connect(socket, &QLocalSocket::connected, this, [this, socket] {
+    qInfo("subscribed to system scope license from another process");
+    connect(socket, &QLocalSocket::readyRead, this, [this, socket] { handleReadyRead(socket); });
+    connect(socket, &QLocalSocket::disconnected, this, &LicenseStateChannel::handleHostLost);
+    m_role = Role::kSubscriber;
+    Q_EMIT roleDecided(m_role);
+  });
+  connect(socket, &QLocalSocket::errorOccurred, this, [this, socket] {
+    // Errors after connecting show up as a disconnect instead.
+    if (m_role == Role::kSubscriber) {
+      return;
+    }
+
+    qDebug().noquote() << "no license host to subscribe to:" << socket->errorString();
+    socket->disconnect(this);
+    socket->deleteLater();
+    m_hostSocket = nullptr;
+    becomeHost();
+  });
+  socket->connectToServer(serverName());
+}
+
+void LicenseStateChannel::becomeHost()
+{
+  if (listen()) {
+    qInfo("hosting system scope license for other processes");
+    m_role = Role::kHost;
+  } else {
+    qWarning("unable to share system scope license, handling it in this process only");
+  }
+
+  Q_EMIT roleDecided(m_role);
+}
+
+void LicenseStateChannel::stop()
+{
+  if (m_hostSocket != nullptr) {
+    m_hostSocket->disconnect(this);
+    m_hostSocket->abort();
+    m_hostSocket->deleteLater();
+    m_hostSocket = nullptr;
+  }
+
+  for (auto socket : std::as_const(m_subscribers)) {
+    socket->disconnect(this);
+    socket->abort();
+    socket->deleteLater();
+  }
+  m_subscribers.clear();
+
+  if (m_server != nullptr) {
+    m_server->close();
+    m_server->deleteLater();
+    m_server = nullptr;
+  }
+
+  m_role = Role::kNone;
+}
+
+bool LicenseStateChannel::listen()
+{
+  m_server = new QLocalServer(this);
+
+  // Every user's GUI shares the machine-wide channel, and subscribers verify the lease
+  // before trusting an activation. Otherwise other users could push a forged state.
+  m_server->setSocketOptions(isMachineWide() ? QLocalServer::WorldAccessOption : QLocalServer::UserAccessOption);
+  connect(m_server, &QLocalServer::newConnection, this, &LicenseStateChannel::handleConnection);
+
+  if (m_server->listen(serverName())) {
+    return true;
+  }
+
+  // On Unix a host that crashed leaves its socket file behind. Nobody answered on it
+  // (or we'd have subscribed), so it's safe to remove.
+  if (m_server->serverError() == QAbstractSocket::AddressInUseError) {
+    qDebug("removing stale license socket");
+    QLocalServer::removeServer(serverName());
+    if (m_server->listen(serverName())) {
+      return true;
+    }
+  }
+
+  qWarning().noquote() << "unable to listen for license subscribers:" << m_server->errorString();
+  m_server->deleteLater();
+  m_server = nullptr;
+  return false;
+}
+
+void LicenseStateChannel::handleConnection()
+{
+  while (m_server->hasPendingConnections()) {
+    auto socket = m_server->nextPendingConnection();
+    qDebug("license subscriber connected");
+
+    m_subscribers.append(socket);
+    connect(socket, &QLocalSocket::readyRead, this, [this, socket] { handleReadyRead(socket); });
+    connect(socket, &QLocalSocket::disconnected, this, [this, socket] {
+      qDebug("license subscriber disconnected");
+      m_subscribers.removeAll(socket);
+      socket->deleteLater();
+    });
+
+    if (!m_lastState.isEmpty()) {
+      send(socket, m_lastState);
+    }
+  }
+}
+
+void LicenseStateChannel::handleReadyRead(QLocalSocket *socket)
+{
+  // One compact JSON object per line.
+  while (socket->canReadLine()) {
+    const auto line = socket->readLine().trimmed();
+    QJsonParseError error;
+    const auto document = QJsonDocument::fromJson(line, &error);
+    if (error.error != QJsonParseError::NoError || !document.isObject()) {
+      qWarning().noquote() << "ignoring invalid license channel message:" << error.errorString();
+      continue;
+    }
+
+    handleMessage(document.object());
+  }
+}
+
+void LicenseStateChannel::handleMessage(const QJsonObject &message)
+{
+  const auto type = message["type"].toString();
+  if (m_role == Role::kSubscriber && type == kTypeState) {
+    Q_EMIT stateReceived(fromJson(message));
+  } else if (m_role == Role::kHost && type == kTypeActivate) {
+    qDebug("license subscriber requested activation");
+    Q_EMIT activationRequested();
+  } else {
+    qDebug().noquote() << "ignoring unexpected license channel message:" << type;
+  }
+}
+
+void LicenseStateChannel::handleHostLost()
+{
+  qInfo("license host went away, trying to take over");
+  m_hostSocket->disconnect(this);
+  m_hostSocket->deleteLater();
+  m_hostSocket = nullptr;
+  m_role = Role::kNone;
+
+  // Another subscriber may win the race to take over, in which case this one subscribes
+  // to it instead.
+  start();
+}
+
+void LicenseStateChannel::publish(const State &state)
+{
+  if (m_role != Role::kHost) {
+    return;
+  }
+
+  m_lastState = toJson(state);
+  for (auto socket : std::as_const(m_subscribers)) {
+    send(socket, m_lastState);
+  }
+}
+
+void LicenseStateChannel::requestActivation()
+{
+  if (m_role != Role::kSubscriber) {
+    return;
+  }
+
+  send(m_hostSocket, {{"type", kTypeActivate}});
+}
+
+void LicenseStateChannel::send(QLocalSocket *socket, const QJsonObject &message) const
+{
+  socket->write(QJsonDocument(message).toJson(QJsonDocument::Compact));
+  socket->write("\n");
+}
+
+QJsonObject LicenseStateChannel::toJson(const State &state)
+{
+  return {
+      {"type", kTypeState},
+      {"serialHash", state.serialHash},
+      {"activated", state.activated},
+      {"lease", state.lease},
+      {"graceStartEpochSecs", state.graceStartEpochSecs},
+      {"lastCheckEpochSecs", state.lastCheckEpochSecs},
+  };
+}
+
+LicenseStateChannel::State LicenseStateChannel::fromJson(const QJsonObject &json)
+{
+  State state;
+  state.serialHash = json["serialHash"].toString();
+  state.activated = json["activated"].toBool();
+  state.lease = json["lease"].toString();
+  state.graceStartEpochSecs = json["graceStartEpochSecs"].toInteger();
+  state.lastCheckEpochSecs = json["lastCheckEpochSecs"].toInteger();
+  return state;
+}
+
+} // namespace synergy::gui::license
@@ -0,0 +1,125 @@
+/*
+ * Synergy -- mouse and keyboard sharing utility
+ * Copyright (C) 2026 Symless Ltd.
+ *
+ * This package is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * found in the file LICENSE that should have accompanied this file.
+ *
+ * This package is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <QJsonObject>
+#include <QList>
+#include <QObject>
+#include <QString>
+
+class QLocalServer;
+class QLocalSocket;
+
+namespace synergy::gui::license {
+
+/**
+ * @brief Shares one system scope license between the GUI processes on a machine.
+ *
+ * The first process to start listens on a local socket and becomes the host; it alone
+ * validates, activates and re-checks the license, and publishes the result to every
+ * other process. When leases can be verified, the socket is machine-wide, so there is
+ * one validation per machine however many users are logged in; otherwise it's only
+ * reachable by the user, and each user's processes share their own. The others subscribe, and ask the host
+ * to activate rather than doing it themselves. If the host goes away, a subscriber
+ * takes over.
+ *
+ * The serial key itself is never sent, only its hash; subscribers read the key from the
+ * shared settings, and should verify the lease before trusting an activation.
+ */
+class LicenseStateChannel : public QObject
+{
+  Q_OBJECT
+
+public:
+  enum class Role
+  {
+    kNone,
+    kHost,
+    kSubscriber
+  };
+
+  struct State
+  {
+    QString serialHash;
+    bool activated = false;
+    QString lease;
+    qint64 graceStartEpochSecs = 0;
+    qint64 lastCheckEpochSecs = 0;
+
+    bool operator==(const State &other) const = default;
+  };
+
+  explicit LicenseStateChannel(QObject *parent = nullptr);
+  ~LicenseStateChannel() override;
+
+  /**
+   * @brief Becomes the host if there isn't one already, otherwise subscribes to it.
+   *
+   * Returns straight away; `roleDecided` is emitted once it's known which it is.
+   */
+  void start();
+  void stop();
+
+  /**
+   * @brief Sends the state to all subscribers; only has an effect on the host.
+   */
+  void publish(const State &state);
+
+  /**
+   * @brief Asks the host to activate the license; only has an effect on a subscriber.
+   */
+  void requestActivation();
+
+  Role role() const
+  {
+    return m_role;
+  }
+
+  static bool isMachineWide();
+  static QString serverName();
+
+signals:
+  void stateReceived(const State &state);
+  void activationRequested();
+
+  /**
+   * @brief Emitted once per start, including when a subscriber starts again because the
+   * host went away. `kNone` means the channel can't be used, so this process is on its own.
+   */
+  void roleDecided(Role role);
+
+private:
+  void becomeHost();
+  bool listen();
+  void handleConnection();
+  void handleReadyRead(QLocalSocket *socket);
+  void handleMessage(const QJsonObject &message);
+  void handleHostLost();
+  void send(QLocalSocket *socket, const QJsonObject &message) const;
+
+  static QJsonObject toJson(const State &state);
+  static State fromJson(const QJsonObject &json);
+
+  Role m_role = Role::kNone;
+  QLocalServer *m_server = nullptr;
+  QLocalSocket *m_hostSocket = nullptr;
+  QList<QLocalSocket *> m_subscribers;
+  QJsonObject m_lastState;
+};
+
+} // namespace synergy::gui::license
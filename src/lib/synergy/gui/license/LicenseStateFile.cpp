@@ -0,0 +1,294 @@
+/*
+ * Synergy -- mouse and keyboard sharing utility
+ * Copyright (C) 2026 Symless Ltd.
+ *
+ * This package is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * found in the file LICENSE that should have accompanied this file.
+ *
+ * This package is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "LicenseStateFile.h"
+
+#include "synergy/gui/constants.h"
+
+#include <QDir>
+#include <QFileInfo>
+#include <QScopeGuard>
+#include <QtCore>
+
+#if defined(Q_OS_WIN)
+#include <io.h>
+#include <windows.h>
+#else
+#include <sys/mman.h>
+#endif
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstring>
+
+namespace synergy::gui::license {
+
+namespace {
+
+const auto kFileName = "license-state.bin";
+const quint32 kMagic = 0x534c5953; // "SYLS"
+const quint16 kVersion = 1;
+
+// A reader copying a slot while it's written sees a bad checksum, so it tries again.
+const auto kReadAttempts = 3;
+
+struct Header
+{
+  quint32 magic;
+  quint16 version;
+  quint16 slotSize;
+  quint8 reserved[56];
+};
+
+struct Slot
+{
+  quint64 sequence;
+  quint32 checksum;
+  quint32 activated;
+  qint64 graceStartEpochSecs;
+  qint64 lastCheckEpochSecs;
+  quint16 serialKeySize;
+  quint16 leaseSize;
+  quint32 reserved;
+  char serialKey[LicenseStateFile::kMaxSerialKeyBytes];
+  char lease[LicenseStateFile::kMaxLeaseBytes];
+};
+
+static_assert(sizeof(Header) + 2 * sizeof(Slot) <= LicenseStateFile::kFileSize);
+static_assert(std::is_trivially_copyable_v<Slot>);
+
+constexpr auto kCrcTable = [] {
+  std::array<quint32, 256> table{};
+  for (quint32 i = 0; i < table.size(); i++) {
+    auto crc = i;
+    for (auto bit = 0; bit < 8; bit++) {
+      crc = (crc & 1) ? (crc >> 1) ^ 0xedb88320 : crc >> 1;
+    }
+    table[i] = crc;
+  }
+  return table;
+}();
+
+quint32 checksum(Slot slot)
+{
+  slot.checksum = 0;
+  const auto *bytes = reinterpret_cast<const uchar *>(&slot);
+  quint32 crc = 0xffffffff;
+  for (std::size_t i = 0; i < sizeof(slot); i++) {
+    crc = kCrcTable[(crc ^ bytes[i]) & 0xff] ^ (crc >> 8);
+  }
+  return ~crc;
+}
+
+bool isValid(const Slot &slot)
+{
+  return slot.sequence != 0 && slot.serialKeySize <= sizeof(slot.serialKey) && slot.leaseSize <= sizeof(slot.lease) &&
+         slot.checksum == checksum(slot);
+}
+
+uchar *slotAt(uchar *data, int index)
+{
+  return data + sizeof(Header) + index * sizeof(Slot);
+}
+
+Slot readSlot(const uchar *data, int index)
+{
+  Slot slot;
+  std::memcpy(&slot, slotAt(const_cast<uchar *>(data), index), sizeof(slot));
+  std::atomic_thread_fence(std::memory_order_acquire);
+  return slot;
+}
+
+bool tryLock(QLockFile &lock, const QString &path)
+{
+  if (lock.tryLock(duration_cast<milliseconds>(kLicenseStateLockWait))) {
+    return true;
+  }
+
+  qWarning().noquote() << "unable to lock license state file, error:" << static_cast<int>(lock.error()) << path;
+  return false;
+}
+
+} // namespace
+
+LicenseStateFile::LicenseStateFile(const QString &path) : m_file(path), m_lock(path + ".lock")
+{
+  m_lock.setStaleLockTime(duration_cast<milliseconds>(kLicenseLockStaleTime));
+}
+
+LicenseStateFile::~LicenseStateFile()
+{
+  if (m_data != nullptr) {
+    m_file.unmap(m_data);
+  }
+}
+
+QString LicenseStateFile::pathFor(const QString &settingsFileName)
+{
+  return QFileInfo(settingsFileName).absoluteDir().filePath(kFileName);
+}
+
+bool LicenseStateFile::open()
+{
+  if (isOpen()) {
+    return true;
+  }
+
+  QDir().mkpath(QFileInfo(m_file.fileName()).absolutePath());
+
+  // Otherwise another process could map the file while it's being created.
+  if (!tryLock(m_lock, m_file.fileName())) {
+    return false;
+  }
+  const auto unlock = qScopeGuard([this] { m_lock.unlock(); });
+
+  if (!m_file.open(QIODevice::ReadWrite)) {
+    qWarning().noquote() << "unable to open license state file:" << m_file.fileName() << m_file.errorString();
+    return false;
+  }
+
+  Header header{};
+  const auto isNew = m_file.size() == 0;
+  if (!isNew) {
+    m_file.read(reinterpret_cast<char *>(&header), sizeof(header));
+    if (header.magic == kMagic && header.version > kVersion) {
+      qWarning().noquote() << "license state file is from a newer version, not using it:" << m_file.fileName();
+      m_file.close();
+      return false;
+    }
+  }
+
+  if (isNew || header.magic != kMagic || header.slotSize != sizeof(Slot) || m_file.size() != kFileSize) {
+    if (!isNew) {
+      qWarning().noquote() << "license state file is not valid, starting again:" << m_file.fileName();
+    }
+
+    header = {kMagic, kVersion, static_cast<quint16>(sizeof(Slot)), {}};
+    if (!m_file.resize(0) || !m_file.resize(kFileSize) || !m_file.seek(0) ||
+        m_file.write(reinterpret_cast<const char *>(&header), sizeof(header)) != sizeof(header) || !m_file.flush()) {
+      qWarning().noquote() << "unable to create license state file:" << m_file.fileName() << m_file.errorString();
+      m_file.close();
+      return false;
+    }
+  }
+
+  m_data = m_file.map(0, kFileSize);
+  if (m_data == nullptr) {
+    qWarning().noquote() << "unable to map license state file:" << m_file.fileName() << m_file.errorString();
+    m_file.close();
+    return false;
+  }
+
+  return true;
+}
+
+std::optional<LicenseStateFile::State> LicenseStateFile::read() const
+{
+  if (!isOpen()) {
+    return std::nullopt;
+  }
+
+  for (auto attempt = 0; attempt < kReadAttempts; attempt++) {
+    const std::array slots = {readSlot(m_data, 0), readSlot(m_data, 1)};
+    const Slot *newest = nullptr;
+    auto written = false;
+    for (const auto &slot : slots) {
+      written = written || slot.sequence != 0;
+      if (isValid(slot) && (newest == nullptr || slot.sequence > newest->sequence)) {
+        newest = &slot;
+      }
+    }
+
+    if (newest != nullptr) {
+      return State{
+          QString::fromUtf8(newest->serialKey, newest->serialKeySize), newest->activated != 0,
+          newest->graceStartEpochSecs, QString::fromUtf8(newest->lease, newest->leaseSize), newest->lastCheckEpochSecs
+      };
+    }
+
+    if (!written) {
+      return std::nullopt;
+    }
+  }
+
+  qWarning().noquote() << "license state file has no valid state:" << m_file.fileName();
+  return std::nullopt;
+}
+
+bool LicenseStateFile::write(const State &state)
+{
+  if (!isOpen()) {
+    return false;
+  }
+
+  const auto serialKey = state.serialKey.toUtf8();
+  const auto lease = state.lease.toUtf8();
+  if (serialKey.size() > kMaxSerialKeyBytes || lease.size() > kMaxLeaseBytes) {
+    qWarning(
+        "license state too large to store, serial key: %lld bytes, lease: %lld bytes",
+        static_cast<long long>(serialKey.size()), static_cast<long long>(lease.size())
+    );
+    return false;
+  }
+
+  if (!tryLock(m_lock, m_file.fileName())) {
+    return false;
+  }
+  const auto unlock = qScopeGuard([this] { m_lock.unlock(); });
+
+  // Overwrite whichever slot isn't the newest valid one, leaving that one to fall back on.
+  const std::array slots = {readSlot(m_data, 0), readSlot(m_data, 1)};
+  const auto sequence0 = isValid(slots[0]) ? slots[0].sequence : 0;
+  const auto sequence1 = isValid(slots[1]) ? slots[1].sequence : 0;
+  const auto target = sequence0 <= sequence1 ? 0 : 1;
+
+  Slot slot{};
+  slot.sequence = std::max(sequence0, sequence1) + 1;
+  slot.activated = state.activated ? 1 : 0;
+  slot.graceStartEpochSecs = state.graceStartEpochSecs;
+  slot.lastCheckEpochSecs = state.lastCheckEpochSecs;
+  slot.serialKeySize = static_cast<quint16>(serialKey.size());
+  slot.leaseSize = static_cast<quint16>(lease.size());
+  std::memcpy(slot.serialKey, serialKey.constData(), serialKey.size());
+  std::memcpy(slot.lease, lease.constData(), lease.size());
+  slot.checksum = checksum(slot);
+
+  std::atomic_thread_fence(std::memory_order_release);
+  std::memcpy(slotAt(m_data, target), &slot, sizeof(slot));
+
+  // Other processes see the write straight away, but the OS may hold it in memory for a
+  // while, so a power cut could lose the update unless it's written out now.
+  if (!flush()) {
+    qWarning().noquote() << "unable to flush license state file:" << m_file.fileName();
+    return false;
+  }
+
+  return true;
+}
+
+bool LicenseStateFile::flush()
+{
+#if defined(Q_OS_WIN)
+  return FlushViewOfFile(m_data, kFileSize) &&
+         FlushFileBuffers(reinterpret_cast<HANDLE>(_get_osfhandle(m_file.handle())));
+#else
+  return msync(m_data, kFileSize, MS_SYNC) == 0;
+#endif
+}
+
+} // namespace synergy::gui::license
@@ -0,0 +1,106 @@
+/*
+ * Synergy -- mouse and keyboard sharing utility
+ * Copyright (C) 2026 Symless Ltd.
+ *
+ * This package is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * found in the file LICENSE that should have accompanied this file.
+ *
+ * This package is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <QFile>
+#include <QLockFile>
+#include <QString>
+
+#include <optional>
+
+namespace synergy::gui::license {
+
+/**
+ * @brief License state in a small binary file that's mapped into memory.
+ *
+ * The file is one 4 KiB page: a header, then two copies (slots) of the state, each
+ * with a sequence number and a CRC-32. Writes go to the older slot, so the newer one
+ * stays intact if a write is cut short, and readers pick the newest slot whose
+ * checksum matches. That means any process can read consistent state with two small
+ * copies, without parsing the settings INI, and every update is one page.
+ *
+ * Writers hold a lock file next to the state file, so two processes can't both pick
+ * the same slot, and each write is flushed to disk before the lock is released.
+ * Values are stored in the machine's byte order, since the file never leaves it.
+ */
+class LicenseStateFile
+{
+public:
+  static constexpr qint64 kFileSize = 4096;
+  static constexpr int kMaxSerialKeyBytes = 512;
+  static constexpr int kMaxLeaseBytes = 1440;
+
+  struct State
+  {
+    QString serialKey;
+    bool activated = false;
+    qint64 graceStartEpochSecs = 0;
+    QString lease;
+    qint64 lastCheckEpochSecs = 0;
+
+    bool operator==(const State &other) const = default;
+  };
+
+  explicit LicenseStateFile(const QString &path);
+  ~LicenseStateFile();
+
+  LicenseStateFile(const LicenseStateFile &) = delete;
+  LicenseStateFile &operator=(const LicenseStateFile &) = delete;
+
+  /**
+   * @brief The state file that goes with a settings file, in the same directory.
+   */
+  static QString pathFor(const QString &settingsFileName);
+
+  /**
+   * @brief Creates the file if needed and maps it.
+   *
+   * @return False if the file can't be used, e.g. it was written by a newer version.
+   */
+  bool open();
+
+  bool isOpen() const
+  {
+    return m_data != nullptr;
+  }
+
+  QString path() const
+  {
+    return m_file.fileName();
+  }
+
+  /**
+   * @return The newest valid state, or nothing if none has been written.
+   */
+  std::optional<State> read() const;
+
+  /**
+   * @return False if not open, if the serial key or lease is too long to store,
+   * if another process holds the lock for too long, or if the flush fails.
+   */
+  bool write(const State &state);
+
+private:
+  bool flush();
+
+  QFile m_file;
+  QLockFile m_lock;
+  uchar *m_data = nullptr;
+};
+
+} // namespace synergy::gui::license
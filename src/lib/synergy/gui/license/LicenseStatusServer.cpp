@@ -0,0 +1,145 @@
+/*
+ * Synergy -- mouse and keyboard sharing utility
+ * Copyright (C) 2026 Symless Ltd.
+ *
+ * This package is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * found in the file LICENSE that should have accompanied this file.
+ *
+ * This package is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "LicenseStatusServer.h"
+
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QLocalServer>
+#include <QLocalSocket>
+#include <QtCore>
+
+namespace synergy::gui::license {
+
+const auto kStaleCheckTimeoutMs = 200;
+
+QByteArray LicenseStatusServer::Status::toJson() const
+{
+  const QJsonObject json{
+      {"edition", edition},
+      {"valid", valid},
+      {"daysLeft", daysLeft.has_value() ? QJsonValue(daysLeft.value()) : QJsonValue()},
+      {"activated", activated},
+      {"graceStartEpochSecs", graceStartEpochSecs},
+      {"lastCheckEpochSecs", lastCheckEpochSecs},
+      {"lastCheckResult", lastCheckResult},
+      {"lastCheckLatencyMs", lastCheckLatencyMs},
+      {"updatedEpochSecs", updatedEpochSecs},
+  };
+  return QJsonDocument(json).toJson(QJsonDocument::Compact) + '\n';
+}
+
+LicenseStatusServer::LicenseStatusServer(QObject *parent)
+    : QObject(parent),
+      m_snapshot(std::make_shared<const QByteArray>(Status{}.toJson()))
+{
+  m_thread.setObjectName("license status");
+}
+
+LicenseStatusServer::~LicenseStatusServer()
+{
+  stop();
+}
+
+QString LicenseStatusServer::socketName(const QString &configured)
+{
+  const auto envVar = qEnvironmentVariable("SYNERGY_LICENSE_STATUS_SOCKET");
+  return envVar.isEmpty() ? configured : envVar;
+}
+
+void LicenseStatusServer::start(const QString &name)
+{
+  if (m_server != nullptr) {
+    return;
+  }
+
+  // Created here but only used on the thread, where its sockets are served too.
+  m_server = new QLocalServer();
+  m_server->setSocketOptions(QLocalServer::WorldAccessOption);
+  m_server->moveToThread(&m_thread);
+  connect(&m_thread, &QThread::finished, m_server, &QObject::deleteLater);
+  connect(m_server, &QLocalServer::newConnection, m_server, [this] { serve(); });
+
+  m_thread.start();
+  QMetaObject::invokeMethod(m_server, [this, name] { listen(name); }, Qt::QueuedConnection);
+}
+
+void LicenseStatusServer::stop()
+{
+  if (m_server == nullptr) {
+    return;
+  }
+
+  m_thread.quit();
+  m_thread.wait();
+  m_server = nullptr;
+}
+
+void LicenseStatusServer::publish(const Status &status)
+{
+  auto snapshot = std::make_shared<const QByteArray>(status.toJson());
+  std::scoped_lock lock(m_mutex);
+  m_snapshot = std::move(snapshot);
+}
+
+QByteArray LicenseStatusServer::snapshot() const
+{
+  std::scoped_lock lock(m_mutex);
+  return *m_snapshot;
+}
+
+void LicenseStatusServer::listen(const QString &name)
+{
+  if (m_server->listen(name)) {
+    qInfo().noquote() << "serving license status on:" << m_server->fullServerName();
+    return;
+  }
+
+  // A process that crashed leaves its socket file behind; only remove it if nobody answers.
+  if (m_server->serverError() == QAbstractSocket::AddressInUseError) {
+    QLocalSocket probe;
+    probe.connectToServer(name);
+    if (!probe.waitForConnected(kStaleCheckTimeoutMs)) {
+      qDebug("removing stale license status socket");
+      QLocalServer::removeServer(name);
+      if (m_server->listen(name)) {
+        qInfo().noquote() << "serving license status on:" << m_server->fullServerName();
+        return;
+      }
+    }
+  }
+
+  qWarning().noquote() << "unable to serve license status:" << m_server->errorString();
+}
+
+void LicenseStatusServer::serve()
+{
+  std::shared_ptr<const QByteArray> snapshot;
+  {
+    std::scoped_lock lock(m_mutex);
+    snapshot = m_snapshot;
+  }
+
+  while (m_server->hasPendingConnections()) {
+    const auto socket = m_server->nextPendingConnection();
+    connect(socket, &QLocalSocket::disconnected, socket, &QObject::deleteLater);
+    socket->write(*snapshot);
+    socket->disconnectFromServer();
+  }
+}
+
+} // namespace synergy::gui::license
@@ -0,0 +1,91 @@
+/*
+ * Synergy -- mouse and keyboard sharing utility
+ * Copyright (C) 2026 Symless Ltd.
+ *
+ * This package is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * found in the file LICENSE that should have accompanied this file.
+ *
+ * This package is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <QByteArray>
+#include <QObject>
+#include <QString>
+#include <QThread>
+
+#include <memory>
+#include <mutex>
+#include <optional>
+
+class QLocalServer;
+
+namespace synergy::gui::license {
+
+/**
+ * @brief Answers monitoring agents with the license status, on a local socket.
+ *
+ * The protocol is read-only: connect, read one line of compact JSON, and the server
+ * closes the connection, e.g. `socat - UNIX-CONNECT:/tmp/synergy-license-status`.
+ *
+ * The status is encoded when it's published, and connections are served on a thread
+ * of their own from that snapshot, so polling never waits on (or for) the GUI thread.
+ */
+class LicenseStatusServer : public QObject
+{
+  Q_OBJECT
+
+public:
+  struct Status
+  {
+    QString edition;
+    bool valid = false;
+    std::optional<qint64> daysLeft;
+    bool activated = false;
+    qint64 graceStartEpochSecs = 0;
+    qint64 lastCheckEpochSecs = 0;
+    QString lastCheckResult;
+    qint64 lastCheckLatencyMs = 0;
+    qint64 updatedEpochSecs = 0;
+
+    QByteArray toJson() const;
+  };
+
+  explicit LicenseStatusServer(QObject *parent = nullptr);
+  ~LicenseStatusServer() override;
+
+  /**
+   * @brief The socket to serve on: a name, or a path on Unix. The env var overrides the
+   *    setting, and empty means don't serve.
+   */
+  static QString socketName(const QString &configured);
+
+  void start(const QString &name);
+  void stop();
+
+  /**
+   * @brief Replaces the status that's served; safe to call from any thread.
+   */
+  void publish(const Status &status);
+
+  QByteArray snapshot() const;
+
+private:
+  void listen(const QString &name);
+  void serve();
+
+  mutable std::mutex m_mutex;
+  std::shared_ptr<const QByteArray> m_snapshot;
+  QThread m_thread;
+  QLocalServer *m_server = nullptr;
+};
+
+} // namespace synergy::gui::license
@@ -0,0 +1,182 @@
+/*
+ * Synergy -- mouse and keyboard sharing utility
+ * Copyright (C) 2026 Symless Ltd.
+ *
+ * This package is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * found in the file LICENSE that should have accompanied this file.
+ *
+ * This package is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "LocalHttpServer.h"
+
+#include "synergy/gui/constants.h"
+
+#include <QTcpServer>
+#include <QTcpSocket>
+#include <QTimer>
+#include <QtCore>
+
+using namespace std::chrono;
+
+namespace synergy::gui::license {
+
+// License requests are a few hundred bytes; anything much bigger isn't one.
+const auto kMaxRequestSize = 64 * 1024;
+
+LocalHttpServer::LocalHttpServer(Handler handler, QObject *parent)
+    : QObject(parent),
+      m_handler(std::move(handler)),
+      m_server(new QTcpServer(this)),
+      m_readTimeout(duration_cast<milliseconds>(kHttpReadTimeout))
+{
+  connect(m_server, &QTcpServer::newConnection, this, &LocalHttpServer::handleConnection);
+}
+
+bool LocalHttpServer::listen(const QHostAddress &address, quint16 port)
+{
+  return m_server->listen(address, port);
+}
+
+void LocalHttpServer::close()
+{
+  m_server->close();
+}
+
+bool LocalHttpServer::isListening() const
+{
+  return m_server->isListening();
+}
+
+quint16 LocalHttpServer::port() const
+{
+  return m_server->serverPort();
+}
+
+QString LocalHttpServer::errorString() const
+{
+  return m_server->errorString();
+}
+
+void LocalHttpServer::setReadTimeout(milliseconds timeout)
+{
+  m_readTimeout = timeout;
+}
+
+void LocalHttpServer::handleConnection()
+{
+  while (m_server->hasPendingConnections()) {
+    auto socket = m_server->nextPendingConnection();
+    m_buffers.insert(socket, {});
+    connect(socket, &QTcpSocket::readyRead, this, [this, socket] { handleReadyRead(socket); });
+    connect(socket, &QTcpSocket::disconnected, this, [this, socket] {
+      m_buffers.remove(socket);
+      socket->deleteLater();
+    });
+
+    // Cancelled if the socket goes first; a handled request is no longer in the buffers.
+    QTimer::singleShot(m_readTimeout, socket, [this, socket] {
+      if (m_buffers.remove(socket)) {
+        qWarning("http request not received in time, closing connection");
+        socket->abort();
+      }
+    });
+  }
+}
+
+void LocalHttpServer::handleReadyRead(QTcpSocket *socket)
+{
+  if (!m_buffers.contains(socket)) {
+    // Already handled (or timed out); one request per connection.
+    socket->readAll();
+    return;
+  }
+
+  auto &buffer = m_buffers[socket];
+  buffer.append(socket->readAll());
+  if (buffer.size() > kMaxRequestSize) {
+    qWarning("http request too large, rejecting");
+    m_buffers.remove(socket);
+    respond(socket, 413, {}, {});
+    return;
+  }
+
+  const auto headerEnd = buffer.indexOf("\r\n\r\n");
+  if (headerEnd < 0) {
+    return;
+  }
+
+  const auto lines = buffer.left(headerEnd).split('\n');
+  const auto requestLine = lines.first().trimmed().split(' ');
+  Request request;
+  qint64 contentLength = 0;
+  auto validLength = true;
+  for (const auto &line : lines.mid(1)) {
+    const auto colon = line.indexOf(':');
+    if (colon < 0) {
+      continue;
+    }
+
+    const auto name = line.left(colon).trimmed().toLower();
+    const auto value = line.mid(colon + 1).trimmed();
+    if (name == "content-type") {
+      request.contentType = value;
+    } else if (name == "content-length") {
+      contentLength = value.toLongLong(&validLength);
+    }
+  }
+
+  if (!validLength || contentLength < 0) {
+    qWarning("http request has an invalid content length, rejecting");
+    m_buffers.remove(socket);
+    respond(socket, 400, {}, {});
+    return;
+  }
+
+  if (contentLength > kMaxRequestSize) {
+    qWarning("http request body too large, rejecting");
+    m_buffers.remove(socket);
+    respond(socket, 413, {}, {});
+    return;
+  }
+
+  const auto bodyStart = headerEnd + 4;
+  if (buffer.size() < bodyStart + contentLength) {
+    return;
+  }
+
+  request.body = buffer.mid(bodyStart, contentLength);
+  m_buffers.remove(socket);
+
+  if (requestLine.size() < 2) {
+    respond(socket, 400, {}, {});
+    return;
+  }
+
+  request.method = requestLine[0];
+  request.path = requestLine[1];
+  m_handler(request, socket);
+}
+
+void LocalHttpServer::respond(QTcpSocket *socket, int code, const QByteArray &contentType, const QByteArray &body)
+{
+  QByteArray response = "HTTP/1.1 " + QByteArray::number(code) + (code == 200 ? " OK" : " Error") + "\r\n";
+  if (!contentType.isEmpty()) {
+    response += "Content-Type: " + contentType + "\r\n";
+  }
+  response += "Content-Length: " + QByteArray::number(body.size()) + "\r\n";
+  response += "Connection: close\r\n\r\n";
+  response += body;
+
+  socket->write(response);
+  socket->disconnectFromHost();
+}
+
+} // namespace synergy::gui::license
@@ -0,0 +1,80 @@
+/*
+ * Synergy -- mouse and keyboard sharing utility
+ * Copyright (C) 2026 Symless Ltd.
+ *
+ * This package is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * found in the file LICENSE that should have accompanied this file.
+ *
+ * This package is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <QByteArray>
+#include <QHash>
+#include <QHostAddress>
+#include <QObject>
+
+#include <chrono>
+#include <functional>
+
+class QTcpServer;
+class QTcpSocket;
+
+namespace synergy::gui::license {
+
+/**
+ * @brief Just enough HTTP to serve license API style requests on the LAN or localhost.
+ *
+ * One request per connection: the handler is given the request and the socket, and
+ * must eventually call `respond` (straight away or later, e.g. after an upstream
+ * request), which closes the connection.
+ *
+ * Requests must be small and arrive within the read timeout, so a client can't tie up
+ * the server by sending slowly or claiming a huge body.
+ */
+class LocalHttpServer : public QObject
+{
+  Q_OBJECT
+
+public:
+  struct Request
+  {
+    QByteArray method;
+    QByteArray path;
+    QByteArray contentType;
+    QByteArray body;
+  };
+
+  using Handler = std::function<void(const Request &request, QTcpSocket *socket)>;
+
+  explicit LocalHttpServer(Handler handler, QObject *parent = nullptr);
+
+  bool listen(const QHostAddress &address, quint16 port);
+  void close();
+  bool isListening() const;
+  quint16 port() const;
+  QString errorString() const;
+  void setReadTimeout(std::chrono::milliseconds timeout);
+
+  static void respond(QTcpSocket *socket, int code, const QByteArray &contentType, const QByteArray &body);
+
+private:
+  void handleConnection();
+  void handleReadyRead(QTcpSocket *socket);
+
+  Handler m_handler;
+  QTcpServer *m_server = nullptr;
+  // Only for connections still sending their request.
+  QHash<QTcpSocket *, QByteArray> m_buffers;
+  std::chrono::milliseconds m_readTimeout;
+};
+
+} // namespace synergy::gui::license
@@ -0,0 +1,125 @@
+/*
+ * Synergy -- mouse and keyboard sharing utility
+ * Copyright (C) 2026 Symless Ltd.
+ *
+ * This package is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * found in the file LICENSE that should have accompanied this file.
+ *
+ * This package is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "MachineFingerprint.h"
+
+#include "synergy/gui/license/license_utils.h"
+
+#include <QCryptographicHash>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QHostInfo>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QSaveFile>
+#include <QStandardPaths>
+#include <QSysInfo>
+#include <QtCore>
+
+namespace synergy::gui::license {
+
+// Files that the OS name comes from; changing one means re-reading it.
+#if defined(Q_OS_LINUX)
+const auto kSourceFiles = QStringList{"/etc/os-release"};
+#else
+const auto kSourceFiles = QStringList{};
+#endif
+
+namespace {
+
+QString sha256Hex(const QByteArray &data)
+{
+  return QCryptographicHash::hash(data, QCryptographicHash::Sha256).toHex();
+}
+
+} // namespace
+
+MachineFingerprint::MachineFingerprint(const QString &cachePath)
+    : m_values(runInBackground<Values>([cachePath] { return load(cachePath); }))
+{
+}
+
+MachineFingerprint::Values MachineFingerprint::values() const
+{
+  return m_values.result();
+}
+
+QString MachineFingerprint::defaultCachePath()
+{
+  const auto dir = QStandardPaths::writableLocation(QStandardPaths::AppLocalDataLocation);
+  return QDir(dir).filePath("machine-fingerprint.json");
+}
+
+MachineFingerprint::Values MachineFingerprint::compute()
+{
+  // Anonymise so a leak doesn't reveal which customer machine the data belongs to.
+  return {
+      sha256Hex(QSysInfo::machineUniqueId()), sha256Hex(QHostInfo::localHostName().toUtf8()),
+      QSysInfo::prettyProductName()
+  };
+}
+
+QString MachineFingerprint::changeKey()
+{
+  QStringList parts{QHostInfo::localHostName(), QSysInfo::kernelVersion(), QSysInfo::currentCpuArchitecture()};
+  for (const auto &path : kSourceFiles) {
+    const QFileInfo info(path);
+    parts.append(QString::number(info.exists() ? info.lastModified().toMSecsSinceEpoch() : 0));
+  }
+  return sha256Hex(parts.join('\n').toUtf8());
+}
+
+MachineFingerprint::Values MachineFingerprint::load(const QString &cachePath)
+{
+  if (cachePath.isEmpty()) {
+    return compute();
+  }
+
+  return {
+      sha256Hex(QSysInfo::machineUniqueId()), sha256Hex(QHostInfo::localHostName().toUtf8()), loadOsName(cachePath)
+  };
+}
+
+QString MachineFingerprint::loadOsName(const QString &cachePath)
+{
+  const auto key = changeKey();
+
+  QFile file(cachePath);
+  if (file.open(QIODevice::ReadOnly)) {
+    const auto cached = QJsonDocument::fromJson(file.readAll()).object();
+    const auto osName = cached["osName"].toString();
+    if (cached["changeKey"].toString() == key && !osName.isEmpty()) {
+      qDebug("using saved os name");
+      return osName;
+    }
+  }
+
+  qDebug("reading os name");
+  const auto osName = QSysInfo::prettyProductName();
+
+  QDir().mkpath(QFileInfo(cachePath).absolutePath());
+  QSaveFile saveFile(cachePath);
+  const QJsonObject json{{"changeKey", key}, {"osName", osName}};
+  if (!saveFile.open(QIODevice::WriteOnly) || saveFile.write(QJsonDocument(json).toJson()) < 0 || !saveFile.commit()) {
+    qWarning().noquote() << "unable to save os name:" << cachePath;
+  }
+
+  return osName;
+}
+
+} // namespace synergy::gui::license
@@ -0,0 +1,72 @@
+/*
+ * Synergy -- mouse and keyboard sharing utility
+ * Copyright (C) 2026 Symless Ltd.
+ *
+ * This package is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * found in the file LICENSE that should have accompanied this file.
+ *
+ * This package is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <QFuture>
+#include <QString>
+
+namespace synergy::gui::license {
+
+/**
+ * @brief Identifies this machine to the license API, without revealing who it is.
+ *
+ * Reading the machine ID and OS name can mean D-Bus calls or reading files in `/etc`,
+ * so it's all done once on the thread pool, starting at construction.
+ *
+ * The machine signature is what leases are bound to, so it's always worked out from
+ * the machine ID, never read back from a file that could be edited. Only the OS name is
+ * saved to disk, along with a key made from things that are cheap to read and that
+ * change when it might (e.g. when `/etc/os-release` was modified).
+ */
+class MachineFingerprint
+{
+public:
+  struct Values
+  {
+    QString machineSignature;
+    QString hostnameSignature;
+    QString osName;
+  };
+
+  /**
+   * @param cachePath Where to save the fingerprint, or empty to always work it out.
+   */
+  explicit MachineFingerprint(const QString &cachePath = defaultCachePath());
+
+  /**
+   * @brief The fingerprint, waiting for it if it's not ready yet.
+   */
+  Values values() const;
+
+  bool isReady() const
+  {
+    return m_values.isFinished();
+  }
+
+  static QString defaultCachePath();
+  static Values compute();
+  static QString changeKey();
+
+private:
+  static Values load(const QString &cachePath);
+  static QString loadOsName(const QString &cachePath);
+
+  QFuture<Values> m_values;
+};
+
+} // namespace synergy::gui::license
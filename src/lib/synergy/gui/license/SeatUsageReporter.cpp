@@ -0,0 +1,276 @@
+/*
+ * Synergy -- mouse and keyboard sharing utility
+ * Copyright (C) 2026 Symless Ltd.
+ *
+ * This package is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * found in the file LICENSE that should have accompanied this file.
+ *
+ * This package is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "SeatUsageReporter.h"
+
+#include "synergy/gui/constants.h"
+#include "synergy/gui/license/LicenseMetrics.h"
+
+#include <QCborValue>
+#include <QCryptographicHash>
+#include <QDateTime>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QJsonDocument>
+#include <QRegularExpression>
+#include <QSaveFile>
+#include <QStandardPaths>
+#include <QtCore>
+
+#include <algorithm>
+
+using namespace std::chrono;
+
+namespace synergy::gui::license {
+
+// Enough of the hash to tell the clients at one site apart.
+const auto kClientSignatureLength = 16;
+
+SeatUsageReporter::SeatUsageReporter(
+    Sender sender, const QString &bufferPath, std::optional<int> seatLimit, QObject *parent
+)
+    : QObject(parent),
+      m_sender(std::move(sender)),
+      m_bufferPath(bufferPath),
+      m_ledger(seatLimit)
+{
+  m_timer.setInterval(duration_cast<milliseconds>(kSeatHeartbeatInterval));
+  connect(&m_timer, &QTimer::timeout, this, &SeatUsageReporter::queueHeartbeat);
+}
+
+QString SeatUsageReporter::defaultBufferPath()
+{
+  const auto dir = QStandardPaths::writableLocation(QStandardPaths::AppLocalDataLocation);
+  return QDir(dir).filePath("seat-heartbeats.jsonl");
+}
+
+void SeatUsageReporter::start()
+{
+  qDebug("starting seat usage reports");
+  m_timer.start();
+
+  // Anything left over from last time (e.g. the machine was offline) goes first.
+  sendBuffered();
+}
+
+void SeatUsageReporter::stop()
+{
+  m_timer.stop();
+}
+
+void SeatUsageReporter::handleLogLine(const QString &line)
+{
+  static const QRegularExpression connected(R"re(client "(.+)" has connected)re");
+  static const QRegularExpression disconnected(R"re(client "(.+)" has disconnected)re");
+
+  // A client only holds one seat, however many times it's logged as connecting.
+  if (const auto match = connected.match(line); match.hasMatch()) {
+    const auto signature = clientSignature(match.captured(1));
+    if (!m_connected.contains(signature)) {
+      m_connected.insert(signature);
+      if (!m_ledger.tryAcquire()) {
+        qWarning("client connected with all %d licensed seats in use", m_ledger.snapshot().limit.value_or(0));
+        m_overLimit.insert(signature);
+      }
+    }
+  } else if (const auto match = disconnected.match(line); match.hasMatch()) {
+    const auto signature = clientSignature(match.captured(1));
+    if (m_connected.remove(signature) && !m_overLimit.remove(signature)) {
+      m_ledger.release();
+      takeFreeSeats();
+    }
+  }
+}
+
+void SeatUsageReporter::setSeatLimit(std::optional<int> limit)
+{
+  m_ledger.setLimit(limit);
+  takeFreeSeats();
+}
+
+void SeatUsageReporter::takeFreeSeats()
+{
+  // Clients over the limit are still connected, so they're next in line for a seat.
+  for (auto it = m_overLimit.begin(); it != m_overLimit.end() && m_ledger.tryAcquire();) {
+    it = m_overLimit.erase(it);
+  }
+}
+
+void SeatUsageReporter::reset()
+{
+  if (!m_connected.isEmpty()) {
+    qDebug("server process changed state, clearing connected clients");
+  }
+
+  // The next heartbeat reports the clients as removed, and the peak before the reset is kept.
+  m_connected.clear();
+  m_overLimit.clear();
+  m_ledger.clear();
+}
+
+QString SeatUsageReporter::clientSignature(const QString &name)
+{
+  // Anonymised, as with the machine signature; the API only needs to tell clients apart.
+  const auto hash = QCryptographicHash::hash(name.toUtf8(), QCryptographicHash::Sha256).toHex();
+  return QString::fromLatin1(hash.left(kClientSignatureLength));
+}
+
+QCborMap SeatUsageReporter::buildHeartbeat()
+{
+  const auto toArray = [](const QSet<QString> &set) {
+    QCborArray array;
+    for (const auto &value : set) {
+      array.append(value);
+    }
+    return array;
+  };
+
+  QCborMap heartbeat;
+  heartbeat[QStringLiteral("time")] = QDateTime::currentSecsSinceEpoch();
+  heartbeat[QStringLiteral("current")] = static_cast<qint64>(m_connected.size());
+  heartbeat[QStringLiteral("peak")] = m_ledger.restartPeak();
+  if (!m_overLimit.isEmpty()) {
+    heartbeat[QStringLiteral("overLimit")] = static_cast<qint64>(m_overLimit.size());
+  }
+
+  if (m_sendFull) {
+    heartbeat[QStringLiteral("machines")] = toArray(m_connected);
+    m_sendFull = false;
+  } else {
+    // Empty lists are left out to keep the usual (nothing changed) heartbeat tiny.
+    const auto added = QSet<QString>(m_connected).subtract(m_reported);
+    const auto removed = QSet<QString>(m_reported).subtract(m_connected);
+    if (!added.isEmpty()) {
+      heartbeat[QStringLiteral("added")] = toArray(added);
+    }
+    if (!removed.isEmpty()) {
+      heartbeat[QStringLiteral("removed")] = toArray(removed);
+    }
+  }
+
+  m_reported = m_connected;
+  return heartbeat;
+}
+
+void SeatUsageReporter::queueHeartbeat()
+{
+  auto lines = readBuffer();
+  lines.append(QJsonDocument(buildHeartbeat().toJsonObject()).toJson(QJsonDocument::Compact));
+
+  if (lines.size() > kMaxBufferedSeatHeartbeats) {
+    // The dropped deltas can't be recovered, so the next heartbeat starts from scratch.
+    qWarning("too many seat heartbeats waiting to be sent, dropping the oldest");
+    const auto dropped = lines.size() - kMaxBufferedSeatHeartbeats;
+    lines = lines.mid(dropped);
+    m_sendFull = true;
+    if (m_sending) {
+      m_droppedWhileSending += dropped;
+    }
+  }
+
+  writeBuffer(lines);
+  sendBuffered();
+}
+
+void SeatUsageReporter::sendBuffered()
+{
+  if (m_sending) {
+    return;
+  }
+
+  const auto lines = readBuffer();
+  if (lines.isEmpty()) {
+    return;
+  }
+
+  QCborArray heartbeats;
+  for (const auto &line : lines) {
+    heartbeats.append(QCborValue::fromJsonValue(QJsonDocument::fromJson(line).object()));
+  }
+
+  qDebug("sending %lld seat heartbeats", static_cast<long long>(heartbeats.size()));
+  m_sending = true;
+  m_droppedWhileSending = 0;
+  const auto sentCount = lines.size();
+  m_sender(heartbeats).then(this, [this, sentCount](const Result &result) {
+    using enum Result::Status;
+    m_sending = false;
+
+    if (result.status == kNetworkError || result.status == kCanceled) {
+      qDebug("seat heartbeats not sent, will retry next interval");
+      if (result.status == kNetworkError) {
+        LicenseMetrics::instance().recordRetry(LicenseMetrics::Retry::kSeatHeartbeats);
+      }
+      return;
+    }
+
+    if (!result.isSuccess()) {
+      // Retrying a rejected batch would only be rejected again.
+      qWarning().noquote() << "license api rejected seat heartbeats, discarding:" << result.message;
+      m_sendFull = true;
+    }
+
+    // More heartbeats may have been queued while these were in flight, and the oldest
+    // dropped to make room, in which case fewer of the sent ones are still at the front.
+    const auto remainingSent = std::max<qsizetype>(0, sentCount - m_droppedWhileSending);
+    writeBuffer(readBuffer().mid(remainingSent));
+  });
+}
+
+QList<QByteArray> SeatUsageReporter::readBuffer() const
+{
+  QFile file(m_bufferPath);
+  if (!file.open(QIODevice::ReadOnly)) {
+    return {};
+  }
+
+  QList<QByteArray> lines;
+  while (!file.atEnd()) {
+    const auto line = file.readLine().trimmed();
+    if (!line.isEmpty()) {
+      lines.append(line);
+    }
+  }
+  return lines;
+}
+
+void SeatUsageReporter::writeBuffer(const QList<QByteArray> &lines) const
+{
+  if (lines.isEmpty()) {
+    QFile::remove(m_bufferPath);
+    return;
+  }
+
+  QDir().mkpath(QFileInfo(m_bufferPath).absolutePath());
+  QSaveFile file(m_bufferPath);
+  if (!file.open(QIODevice::WriteOnly)) {
+    qWarning().noquote() << "unable to write seat heartbeats:" << m_bufferPath;
+    return;
+  }
+
+  for (const auto &line : lines) {
+    file.write(line);
+    file.write("\n");
+  }
+
+  if (!file.commit()) {
+    qWarning().noquote() << "unable to save seat heartbeats:" << m_bufferPath;
+  }
+}
+
+} // namespace synergy::gui::license
@@ -0,0 +1,111 @@
+/*
+ * Synergy -- mouse and keyboard sharing utility
+ * Copyright (C) 2026 Symless Ltd.
+ *
+ * This package is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * found in the file LICENSE that should have accompanied this file.
+ *
+ * This package is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include "synergy/gui/license/LicenseApiClient.h"
+#include "synergy/license/SeatLedger.h"
+
+#include <QCborArray>
+#include <QCborMap>
+#include <QFuture>
+#include <QObject>
+#include <QSet>
+#include <QString>
+#include <QTimer>
+
+#include <functional>
+#include <optional>
+
+class SeatUsageReporterTests;
+
+namespace synergy::gui::license {
+
+/**
+ * @brief Reports how many seats a business license uses, from the server machine.
+ *
+ * Client connections are counted from the server's log in a seat ledger, limited to the
+ * serial key's seats if it has a limit, and once per interval a single heartbeat with
+ * the current client count and peak seats is queued. The server has already let every
+ * client in, so clients beyond the limit are still counted as connected, and take a
+ * seat as soon as one is free; the heartbeat says how many are over the limit.
+ * Heartbeats only carry the clients that connected or went away since the previous one,
+ * with the full set sent first and again after any heartbeats were lost.
+ *
+ * Queued heartbeats are kept on disk until the license API accepts them, so usage
+ * while offline is sent in one request when the connection comes back.
+ */
+class SeatUsageReporter : public QObject
+{
+  Q_OBJECT
+
+  friend class ::SeatUsageReporterTests;
+
+  using Result = LicenseApiClient::Result;
+
+public:
+  using Sender = std::function<QFuture<Result>(const QCborArray &heartbeats)>;
+
+  explicit SeatUsageReporter(
+      Sender sender, const QString &bufferPath, std::optional<int> seatLimit = std::nullopt, QObject *parent = nullptr
+  );
+
+  void start();
+  void stop();
+
+  void handleLogLine(const QString &line);
+
+  /**
+   * @brief Forgets every client, for when the server process stops or starts.
+   *
+   * A server that stops or crashes doesn't log its clients disconnecting, so without
+   * this they would hold their seats until the GUI is restarted.
+   */
+  void reset();
+
+  /**
+   * @brief Changes the seat limit, e.g. when the serial key changes.
+   */
+  void setSeatLimit(std::optional<int> limit);
+
+  static QString defaultBufferPath();
+
+private:
+  void takeFreeSeats();
+  void queueHeartbeat();
+  void sendBuffered();
+  QCborMap buildHeartbeat();
+  QList<QByteArray> readBuffer() const;
+  void writeBuffer(const QList<QByteArray> &lines) const;
+  static QString clientSignature(const QString &name);
+
+  Sender m_sender;
+  QString m_bufferPath;
+  QTimer m_timer;
+  synergy::license::SeatLedger m_ledger;
+  // Which clients hold the ledger's seats, so heartbeats can say who came and went.
+  QSet<QString> m_connected;
+  // Connected clients that didn't get a seat, as the limit had been reached.
+  QSet<QString> m_overLimit;
+  QSet<QString> m_reported;
+  bool m_sendFull = true;
+  bool m_sending = false;
+  // Heartbeats dropped from the front of the buffer since the send in flight started.
+  qsizetype m_droppedWhileSending = 0;
+};
+
+} // namespace synergy::gui::license
@@ -18,6 +18,7 @@
 #include "license_utils.h"
 
 #include "gui/string_utils.h"
+#include "synergy/gui/constants.h"
 #include "synergy/license/parse_serial_key.h"
 
 #include <QString>
@@ -40,6 +41,27 @@ bool isActivationEnabled()
   }
 }
 
+bool isOptimisticStartEnabled(bool configured)
+{
+#ifdef NDEBUG
+  // Only admins may skip waiting for activation in release builds, not anyone who can set an env var.
+  return configured;
+#else
+  const auto envVar = qEnvironmentVariable("SYNERGY_LICENSE_OPTIMISTIC_START");
+  return envVar.isEmpty() ? configured : strToTrue(envVar);
+#endif // NDEBUG
+}
+
+std::chrono::milliseconds activationRetryDelay()
+{
+#ifndef NDEBUG
+  if (const auto envVar = qEnvironmentVariable("SYNERGY_TEST_ACTIVATION_RETRY_MS"); !envVar.isEmpty()) {
+    return std::chrono::milliseconds{envVar.toLongLong()};
+  }
+#endif // NDEBUG
+  return std::chrono::duration_cast<std::chrono::milliseconds>(synergy::gui::kLicenseActivationRetryDelay);
+}
+
 synergy::license::SerialKey parseSerialKey(const QString &hexString)
 {
   try {
@@ -17,13 +17,49 @@
 
 #pragma once
 
+#include <QFuture>
+#include <QPromise>
 #include <QString>
+#include <QThreadPool>
 
 #include "synergy/license/SerialKey.h"
 
+#include <chrono>
+#include <functional>
+#include <memory>
+
 namespace synergy::gui::license {
 
 bool isActivationEnabled();
+
+/**
+ * @brief Whether to start the core before activation finishes, and only stop it if the
+ *    key is rejected. In debug builds, the env var overrides the setting.
+ */
+bool isOptimisticStartEnabled(bool configured);
+
+/**
+ * @brief First delay before activating again after a network error, while the core runs
+ *    unactivated. In debug builds, an env var can shorten it for tests.
+ */
+std::chrono::milliseconds activationRetryDelay();
+
 synergy::license::SerialKey parseSerialKey(const QString &hexString);
 
+/**
+ * @brief Runs the work on the global thread pool, so slow startup steps (e.g. reading
+ *    settings from disk) don't hold up the GUI thread.
+ */
+template <typename T> QFuture<T> runInBackground(std::function<T()> work)
+{
+  auto promise = std::make_shared<QPromise<T>>();
+  promise->start();
+  auto future = promise->future();
+  QThreadPool::globalInstance()->start([promise, work = std::move(work)] {
+    promise->addResult(work());
+    promise->finish();
+  });
+  return future;
+}
+
 } // namespace synergy::gui::license
@@ -0,0 +1,110 @@
+/*
+ * Synergy -- mouse and keyboard sharing utility
+ * Copyright (C) 2026 Symless Ltd.
+ *
+ * This package is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * found in the file LICENSE that should have accompanied this file.
+ *
+ * This package is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "license_wire.h"
+
+#include "gui/string_utils.h"
+
+#include <QCborValue>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QtCore>
+
+namespace synergy::gui::license {
+
+WireFormat requestWireFormat()
+{
+  if (strToTrue(qEnvironmentVariable("SYNERGY_LICENSE_API_CBOR"))) {
+    return WireFormat::kCbor;
+  } else {
+    return WireFormat::kJson;
+  }
+}
+
+QByteArray contentType(WireFormat format)
+{
+  return format == WireFormat::kCbor ? kContentTypeCbor : kContentTypeJson;
+}
+
+QByteArray acceptHeader(WireFormat format)
+{
+  // Servers that don't speak CBOR ignore the preference and reply with JSON.
+  if (format == WireFormat::kCbor) {
+    return QByteArray(kContentTypeCbor) + ", " + kContentTypeJson + ";q=0.9";
+  } else {
+    return kContentTypeJson;
+  }
+}
+
+WireFormat responseWireFormat(const QString &contentType)
+{
+  if (contentType.startsWith(kContentTypeCbor, Qt::CaseInsensitive)) {
+    return WireFormat::kCbor;
+  } else {
+    return WireFormat::kJson;
+  }
+}
+
+QByteArray encodeMessage(const QCborMap &message, WireFormat format)
+{
+  if (format == WireFormat::kCbor) {
+    return message.toCborValue().toCbor();
+  } else {
+    return QJsonDocument(message.toJsonObject()).toJson(QJsonDocument::Compact);
+  }
+}
+
+QCborMap decodeMessage(const QByteArray &body, WireFormat format, bool *ok)
+{
+  if (ok != nullptr) {
+    *ok = false;
+  }
+
+  if (body.isEmpty()) {
+    return {};
+  }
+
+  if (format == WireFormat::kCbor) {
+    // Parses straight from the reply buffer, which is implicitly shared, so the
+    // body is never copied or converted to text on the way in.
+    QCborParserError error;
+    const auto value = QCborValue::fromCbor(body, &error);
+    if (error.error != QCborError::NoError || !value.isMap()) {
+      qWarning().noquote() << "invalid cbor license message:" << error.errorString();
+      return {};
+    }
+
+    if (ok != nullptr) {
+      *ok = true;
+    }
+    return value.toMap();
+  }
+
+  QJsonParseError error;
+  const auto document = QJsonDocument::fromJson(body, &error);
+  if (error.error != QJsonParseError::NoError || !document.isObject()) {
+    qWarning().noquote() << "invalid json license message:" << error.errorString();
+    return {};
+  }
+
+  if (ok != nullptr) {
+    *ok = true;
+  }
+  return QCborMap::fromJsonObject(document.object());
+}
+
+} // namespace synergy::gui::license
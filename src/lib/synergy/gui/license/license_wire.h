@@ -0,0 +1,48 @@
+/*
+ * Synergy -- mouse and keyboard sharing utility
+ * Copyright (C) 2026 Symless Ltd.
+ *
+ * This package is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * found in the file LICENSE that should have accompanied this file.
+ *
+ * This package is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <QByteArray>
+#include <QCborMap>
+#include <QString>
+
+namespace synergy::gui::license {
+
+/**
+ * @brief Body encoding used for license API requests and responses.
+ *
+ * JSON is always understood by the server; CBOR is only sent when enabled, and
+ * is only decoded when the server says so in the `Content-Type` header.
+ */
+enum class WireFormat
+{
+  kJson,
+  kCbor
+};
+
+const auto kContentTypeJson = "application/json";
+const auto kContentTypeCbor = "application/cbor";
+
+WireFormat requestWireFormat();
+QByteArray contentType(WireFormat format);
+QByteArray acceptHeader(WireFormat format);
+WireFormat responseWireFormat(const QString &contentType);
+QByteArray encodeMessage(const QCborMap &message, WireFormat format);
+QCborMap decodeMessage(const QByteArray &body, WireFormat format, bool *ok = nullptr);
+
+} // namespace synergy::gui::license
@@ -0,0 +1,90 @@
+/*
+ * Synergy -- mouse and keyboard sharing utility
+ * Copyright (C) 2026 Symless Ltd.
+ *
+ * This package is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * found in the file LICENSE that should have accompanied this file.
+ *
+ * This package is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "metrics.h"
+
+#include <algorithm>
+#include <utility>
+
+using namespace std::chrono;
+
+namespace synergy::gui::metrics {
+
+namespace {
+
+double toSeconds(microseconds duration)
+{
+  return duration_cast<duration<double>>(duration).count();
+}
+
+QString withLabel(const QString &labels, const QString &label)
+{
+  return labels.isEmpty() ? label : QString("%1,%2").arg(labels, label);
+}
+
+} // namespace
+
+Histogram::Histogram(std::vector<microseconds> bounds)
+    : m_bounds(std::move(bounds)),
+      m_buckets(std::make_unique<Counter[]>(m_bounds.size() + 1))
+{
+}
+
+void Histogram::observe(microseconds duration)
+{
+  const auto bucket = std::lower_bound(m_bounds.begin(), m_bounds.end(), duration) - m_bounds.begin();
+  m_buckets[bucket].add();
+  m_sumMicros.add(static_cast<std::uint64_t>(std::max(duration.count(), microseconds::rep{0})));
+  m_count.add();
+}
+
+void Histogram::write(QString &out, const char *name, const QString &labels) const
+{
+  const auto bucketName = QString("%1_bucket").arg(QLatin1StringView(name)).toUtf8();
+
+  // Prometheus buckets are cumulative: each counts everything up to its bound.
+  std::uint64_t cumulative = 0;
+  for (std::size_t i = 0; i < m_bounds.size(); i++) {
+    cumulative += m_buckets[i].value();
+    const auto le = QString(R"(le="%1")").arg(toSeconds(m_bounds[i]));
+    writeSample(out, bucketName.constData(), withLabel(labels, le), static_cast<double>(cumulative));
+  }
+  cumulative += m_buckets[m_bounds.size()].value();
+  writeSample(out, bucketName.constData(), withLabel(labels, R"(le="+Inf")"), static_cast<double>(cumulative));
+
+  const auto sumName = QString("%1_sum").arg(QLatin1StringView(name)).toUtf8();
+  const auto countName = QString("%1_count").arg(QLatin1StringView(name)).toUtf8();
+  writeSample(out, sumName.constData(), labels, toSeconds(microseconds{m_sumMicros.value()}));
+  writeSample(out, countName.constData(), labels, static_cast<double>(m_count.value()));
+}
+
+void writeHeader(QString &out, const char *name, const char *type, const char *help)
+{
+  out += QString("# HELP %1 %2\n# TYPE %1 %3\n")
+             .arg(QLatin1StringView(name), QLatin1StringView(help), QLatin1StringView(type));
+}
+
+void writeSample(QString &out, const char *name, const QString &labels, double value)
+{
+  if (labels.isEmpty()) {
+    out += QString("%1 %2\n").arg(QLatin1StringView(name)).arg(value, 0, 'g', 15);
+  } else {
+    out += QString("%1{%2} %3\n").arg(QLatin1StringView(name), labels).arg(value, 0, 'g', 15);
+  }
+}
+
+} // namespace synergy::gui::metrics
@@ -0,0 +1,114 @@
+/*
+ * Synergy -- mouse and keyboard sharing utility
+ * Copyright (C) 2026 Symless Ltd.
+ *
+ * This package is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * found in the file LICENSE that should have accompanied this file.
+ *
+ * This package is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <QString>
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+/**
+ * @brief Metric types that can be updated from any thread with relaxed atomics, and
+ * written out in the Prometheus text format.
+ *
+ * Updates don't order anything else, so a reader may see one metric's update before
+ * another's that happened first; that's fine for monitoring, not for logic.
+ */
+namespace synergy::gui::metrics {
+
+class Counter
+{
+public:
+  void add(std::uint64_t count = 1)
+  {
+    m_value.fetch_add(count, std::memory_order_relaxed);
+  }
+
+  std::uint64_t value() const
+  {
+    return m_value.load(std::memory_order_relaxed);
+  }
+
+private:
+  std::atomic_uint64_t m_value = 0;
+};
+
+class Gauge
+{
+public:
+  void set(std::int64_t value)
+  {
+    m_value.store(value, std::memory_order_relaxed);
+  }
+
+  std::int64_t value() const
+  {
+    return m_value.load(std::memory_order_relaxed);
+  }
+
+private:
+  std::atomic_int64_t m_value = 0;
+};
+
+/**
+ * @brief Counts durations into fixed buckets, written out in seconds.
+ */
+class Histogram
+{
+public:
+  /**
+   * @param bounds Upper bound of each bucket, in ascending order; an unbounded bucket
+   *    is added after the last.
+   */
+  explicit Histogram(std::vector<std::chrono::microseconds> bounds);
+
+  void observe(std::chrono::microseconds duration);
+
+  std::uint64_t count() const
+  {
+    return m_count.value();
+  }
+
+  /**
+   * @brief Appends `_bucket`, `_sum` and `_count` samples.
+   *
+   * @param labels Already formatted, e.g. `endpoint="check"`, or empty.
+   */
+  void write(QString &out, const char *name, const QString &labels = {}) const;
+
+private:
+  std::vector<std::chrono::microseconds> m_bounds;
+  std::unique_ptr<Counter[]> m_buckets;
+  Counter m_count;
+  Counter m_sumMicros;
+};
+
+/**
+ * @brief Appends the `# HELP` and `# TYPE` lines that come before a metric's samples.
+ */
+void writeHeader(QString &out, const char *name, const char *type, const char *help);
+
+/**
+ * @param labels Already formatted, e.g. `endpoint="check"`, or empty.
+ */
+void writeSample(QString &out, const char *name, const QString &labels, double value);
+
+} // namespace synergy::gui::metrics
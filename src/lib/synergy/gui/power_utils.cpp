@@ -0,0 +1,114 @@
+/*
+ * Synergy -- mouse and keyboard sharing utility
+ * Copyright (C) 2026 Symless Ltd.
+ *
+ * This package is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * found in the file LICENSE that should have accompanied this file.
+ *
+ * This package is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "power_utils.h"
+
+#include <QtGlobal>
+
+#if defined(Q_OS_WIN)
+#include <windows.h>
+#elif defined(Q_OS_MAC)
+#include <ApplicationServices/ApplicationServices.h>
+#include <IOKit/ps/IOPSKeys.h>
+#include <IOKit/ps/IOPowerSources.h>
+#else
+#include <QDir>
+#include <QFile>
+#endif
+
+using namespace std::chrono;
+
+namespace synergy::gui {
+
+#if defined(Q_OS_WIN)
+
+bool isOnBatteryPower()
+{
+  SYSTEM_POWER_STATUS status;
+  if (!GetSystemPowerStatus(&status)) {
+    return false;
+  }
+
+  const auto kOffline = 0;
+  return status.ACLineStatus == kOffline;
+}
+
+seconds userIdleTime()
+{
+  LASTINPUTINFO info;
+  info.cbSize = sizeof(info);
+  if (!GetLastInputInfo(&info)) {
+    return seconds{0};
+  }
+
+  return duration_cast<seconds>(milliseconds{GetTickCount() - info.dwTime});
+}
+
+#elif defined(Q_OS_MAC)
+
+bool isOnBatteryPower()
+{
+  const auto info = IOPSCopyPowerSourcesInfo();
+  if (info == nullptr) {
+    return false;
+  }
+
+  // Not owned by us, released along with the info.
+  const auto type = IOPSGetProvidingPowerSourceType(info);
+  const auto onBattery = type != nullptr && CFStringCompare(type, CFSTR(kIOPMBatteryPowerKey), 0) == kCFCompareEqualTo;
+  CFRelease(info);
+  return onBattery;
+}
+
+seconds userIdleTime()
+{
+  const auto idle = CGEventSourceSecondsSinceLastEventType(kCGEventSourceStateCombinedSessionState, kCGAnyInputEventType);
+  return seconds{static_cast<seconds::rep>(idle)};
+}
+
+#else
+
+bool isOnBatteryPower()
+{
+  // Laptops have a mains adapter entry that goes offline when unplugged; desktops
+  // usually have no power supply entries at all.
+  const QDir dir("/sys/class/power_supply");
+  bool hasMains = false;
+  for (const auto &name : dir.entryList(QDir::Dirs | QDir::NoDotAndDotDot)) {
+    QFile typeFile(dir.filePath(name + "/type"));
+    if (!typeFile.open(QIODevice::ReadOnly) || typeFile.readAll().trimmed() != "Mains") {
+      continue;
+    }
+
+    hasMains = true;
+    QFile onlineFile(dir.filePath(name + "/online"));
+    if (onlineFile.open(QIODevice::ReadOnly) && onlineFile.readAll().trimmed() == "1") {
+      return false;
+    }
+  }
+
+  return hasMains;
+}
+
+seconds userIdleTime()
+{
+  return seconds{0};
+}
+
+#endif
+
+} // namespace synergy::gui
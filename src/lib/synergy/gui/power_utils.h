@@ -0,0 +1,39 @@
+/*
+ * Synergy -- mouse and keyboard sharing utility
+ * Copyright (C) 2026 Symless Ltd.
+ *
+ * This package is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * found in the file LICENSE that should have accompanied this file.
+ *
+ * This package is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <chrono>
+
+namespace synergy::gui {
+
+/**
+ * @brief True if the machine is known to be running on battery.
+ *
+ * Returns false when the power source can't be determined.
+ */
+bool isOnBatteryPower();
+
+/**
+ * @brief Time since the last keyboard or mouse input on this machine.
+ *
+ * Returns zero when idle time can't be determined (e.g. on Linux, where there is
+ * no display-server independent way to ask).
+ */
+std::chrono::seconds userIdleTime();
+
+} // namespace synergy::gui
@@ -0,0 +1,170 @@
+/*
+ * Synergy -- mouse and keyboard sharing utility
+ * Copyright (C) 2026 Symless Ltd.
+ *
+ * This package is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * found in the file LICENSE that should have accompanied this file.
+ *
+ * This package is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "trace.h"
+
+#include "synergy/gui/constants.h"
+
+#include <QCoreApplication>
+#include <QFile>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QtCore>
+
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+using namespace std::chrono;
+
+namespace synergy::gui::trace {
+
+namespace {
+
+struct Event
+{
+  const char *name;
+  qint64 startUs;
+  qint64 durationUs;
+};
+
+/**
+ * @brief Written by one thread only; `count` publishes each event to the exporter.
+ */
+struct ThreadBuffer
+{
+  explicit ThreadBuffer(int tid) : tid(tid), events(std::make_unique<Event[]>(kTraceBufferEvents))
+  {
+  }
+
+  const int tid;
+  std::unique_ptr<Event[]> events;
+  std::atomic_size_t count = 0;
+  std::atomic_uint64_t dropped = 0;
+};
+
+const auto g_startTime = steady_clock::now();
+
+// Buffers are shared so that they outlive their threads until they're exported.
+std::mutex g_buffersMutex;
+std::vector<std::shared_ptr<ThreadBuffer>> g_buffers;
+thread_local ThreadBuffer *t_buffer = nullptr;
+
+ThreadBuffer &threadBuffer()
+{
+  if (t_buffer == nullptr) {
+    std::scoped_lock lock(g_buffersMutex);
+    const auto buffer = std::make_shared<ThreadBuffer>(static_cast<int>(g_buffers.size()));
+    g_buffers.push_back(buffer);
+    t_buffer = buffer.get();
+  }
+  return *t_buffer;
+}
+
+} // namespace
+
+void setEnabled(bool enabled)
+{
+  detail::g_enabled = enabled;
+}
+
+void startForApp()
+{
+  static auto started = false;
+  if (started || QCoreApplication::instance() == nullptr) {
+    return;
+  }
+  started = true;
+
+  const auto path = qEnvironmentVariable("SYNERGY_TRACE_FILE");
+  if (path.isEmpty()) {
+    return;
+  }
+
+  qInfo().noquote() << "recording trace to:" << path;
+  setEnabled(true);
+  QObject::connect(QCoreApplication::instance(), &QCoreApplication::aboutToQuit, [path] {
+    setEnabled(false);
+    writeFile(path);
+  });
+}
+
+qint64 nowMicros()
+{
+  return duration_cast<microseconds>(steady_clock::now() - g_startTime).count();
+}
+
+void complete(const char *name, qint64 startUs, qint64 durationUs)
+{
+  auto &buffer = threadBuffer();
+  const auto index = buffer.count.load(std::memory_order_relaxed);
+  if (index >= kTraceBufferEvents) {
+    buffer.dropped.fetch_add(1, std::memory_order_relaxed);
+    return;
+  }
+
+  buffer.events[index] = {name, startUs, durationUs};
+  buffer.count.store(index + 1, std::memory_order_release);
+}
+
+bool writeFile(const QString &path)
+{
+  std::vector<std::shared_ptr<ThreadBuffer>> buffers;
+  {
+    std::scoped_lock lock(g_buffersMutex);
+    buffers = g_buffers;
+  }
+
+  const auto pid = QCoreApplication::applicationPid();
+  QJsonArray events;
+  quint64 dropped = 0;
+  for (const auto &buffer : buffers) {
+    const auto count = buffer->count.load(std::memory_order_acquire);
+    dropped += buffer->dropped.load(std::memory_order_relaxed);
+    for (std::size_t i = 0; i < count; i++) {
+      const auto &event = buffer->events[i];
+      events.append(QJsonObject{
+          {"name", event.name},
+          {"cat", "synergy"},
+          {"ph", "X"},
+          {"ts", event.startUs},
+          {"dur", event.durationUs},
+          {"pid", pid},
+          {"tid", buffer->tid},
+      });
+    }
+  }
+
+  if (dropped > 0) {
+    qWarning("trace buffers were full, dropped %llu events", static_cast<unsigned long long>(dropped));
+  }
+
+  QFile file(path);
+  if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+    qWarning().noquote() << "unable to write trace file:" << path << file.errorString();
+    return false;
+  }
+
+  const QJsonObject trace{{"traceEvents", events}, {"displayTimeUnit", "ms"}};
+  file.write(QJsonDocument(trace).toJson(QJsonDocument::Compact));
+  qInfo("wrote %lld trace events to: %s", static_cast<long long>(events.size()), qUtf8Printable(path));
+  return true;
+}
+
+} // namespace synergy::gui::trace
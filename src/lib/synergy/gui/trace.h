@@ -0,0 +1,100 @@
+/*
+ * Synergy -- mouse and keyboard sharing utility
+ * Copyright (C) 2026 Symless Ltd.
+ *
+ * This package is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * found in the file LICENSE that should have accompanied this file.
+ *
+ * This package is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <QString>
+
+#include <atomic>
+
+/**
+ * @brief Timing spans that can be opened in Chrome's trace viewer (or Perfetto).
+ *
+ * Set `SYNERGY_TRACE_FILE` to a path and spans are recorded from the main window hook
+ * onwards, then written as trace event JSON when the app quits. Each thread appends
+ * to a buffer of its own without locking, and the buffers are only read on export.
+ * With tracing off, a span costs a relaxed load and a branch.
+ */
+namespace synergy::gui::trace {
+
+namespace detail {
+inline std::atomic_bool g_enabled = false;
+}
+
+inline bool isEnabled()
+{
+  return detail::g_enabled.load(std::memory_order_relaxed);
+}
+
+/**
+ * @brief Turns recording on or off; for tests, since apps use `startForApp`.
+ */
+void setEnabled(bool enabled);
+
+/**
+ * @brief Starts recording if `SYNERGY_TRACE_FILE` is set, writing the file on quit.
+ *
+ * Must be called once the app exists; later calls do nothing.
+ */
+void startForApp();
+
+/**
+ * @brief Microseconds on the trace clock, which starts with the process.
+ */
+qint64 nowMicros();
+
+/**
+ * @brief Records a span that has already ended, e.g. a network request phase.
+ *
+ * @param name Must outlive the trace, e.g. a string literal.
+ */
+void complete(const char *name, qint64 startUs, qint64 durationUs);
+
+/**
+ * @brief Writes everything recorded so far as trace event JSON.
+ */
+bool writeFile(const QString &path);
+
+/**
+ * @brief Records the time from construction to destruction as a span.
+ */
+class Span
+{
+public:
+  explicit Span(const char *name) : m_name(name)
+  {
+    if (isEnabled()) [[unlikely]] {
+      m_startUs = nowMicros();
+    }
+  }
+
+  ~Span()
+  {
+    if (m_startUs >= 0) [[unlikely]] {
+      complete(m_name, m_startUs, nowMicros() - m_startUs);
+    }
+  }
+
+  Span(const Span &) = delete;
+  Span &operator=(const Span &) = delete;
+
+private:
+  const char *m_name;
+  qint64 m_startUs = -1;
+};
+
+} // namespace synergy::gui::trace
@@ -18,7 +18,10 @@
 #pragma once
 
 #include "synergy/gui/FeatureHandler.h"
+#include "synergy/gui/StallWatchdog.h"
 #include "synergy/gui/license/LicenseHandler.h"
+#include "synergy/gui/license/LicenseMetrics.h"
+#include "synergy/gui/trace.h"
 #include "synergy/hooks/gui_hook_config.h" // IWYU pragma: keep
 
 #include <QCheckBox>
@@ -34,12 +37,19 @@ namespace synergy::hooks {
 
 inline void onMainWindow(QMainWindow *mainWindow, AppConfig *appConfig, deskflow::gui::CoreProcess *coreProcess)
 {
+  synergy::gui::trace::startForApp();
+  synergy::gui::StallWatchdog::startForApp();
+  synergy::gui::license::LicenseMetrics::startForApp();
+  synergy::gui::StallWatchdog::Scope scope("hooks::onMainWindow");
+  synergy::gui::trace::Span span("hooks::onMainWindow");
   LicenseHandler::instance().handleMainWindow(mainWindow, appConfig, coreProcess);
   FeatureHandler::instance().handleMainWindow(appConfig);
 }
 
 inline bool onAppStart()
 {
+  synergy::gui::StallWatchdog::Scope scope("hooks::onAppStart");
+  synergy::gui::trace::Span span("hooks::onAppStart");
   return LicenseHandler::instance().handleAppStart();
 }
 
@@ -48,17 +58,23 @@ inline void onSettings(
     QRadioButton *userScope
 )
 {
+  synergy::gui::StallWatchdog::Scope scope("hooks::onSettings");
+  synergy::gui::trace::Span span("hooks::onSettings");
   LicenseHandler::instance().handleSettings(parent, enableTls, invertConnection, systemScope, userScope);
   FeatureHandler::instance().handleSettings(parent, systemScope, userScope);
 }
 
 inline void onVersionCheck(QString &versionUrl)
 {
+  synergy::gui::StallWatchdog::Scope scope("hooks::onVersionCheck");
+  synergy::gui::trace::Span span("hooks::onVersionCheck");
   return LicenseHandler::instance().handleVersionCheck(versionUrl);
 }
 
 inline bool onCoreStart()
 {
+  synergy::gui::StallWatchdog::Scope scope("hooks::onCoreStart");
+  synergy::gui::trace::Span span("hooks::onCoreStart");
   return LicenseHandler::instance().handleCoreStart();
 }
 
@@ -30,11 +30,14 @@ class LicenseTests;
 
 namespace synergy::license {
 
+class LicenseLifecycle;
+
 class License
 {
   friend class ::Server;
   friend class ::LicenseHandler;
   friend class ::LicenseTests;
+  friend class LicenseLifecycle;
 
   using days = std::chrono::days;
   using system_clock = std::chrono::system_clock;
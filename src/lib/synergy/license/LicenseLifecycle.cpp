@@ -0,0 +1,128 @@
+/*
+ * Synergy -- mouse and keyboard sharing utility
+ * Copyright (C) 2026 Symless Ltd.
+ *
+ * This package is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * found in the file LICENSE that should have accompanied this file.
+ *
+ * This package is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "LicenseLifecycle.h"
+
+using namespace std::chrono;
+
+namespace synergy::license {
+
+LicenseLifecycle::LicenseLifecycle(const SerialKey &serialKey, seconds gracePeriod, NowFunc nowFunc)
+    : m_license(serialKey),
+      m_gracePeriod(gracePeriod),
+      m_nowFunc(std::move(nowFunc))
+{
+  m_license.setNowFunc(m_nowFunc);
+}
+
+LicenseLifecycle::State LicenseLifecycle::state() const
+{
+  using enum State;
+
+  if (m_license.isExpired()) {
+    return kExpired;
+  } else if (m_disabled) {
+    return kDisabled;
+  } else if (!m_activated) {
+    return kUnactivated;
+  } else if (isInGracePeriod()) {
+    return kGracePeriod;
+  } else if (m_license.isExpiringSoon()) {
+    return kExpiringSoon;
+  } else {
+    return kActive;
+  }
+}
+
+void LicenseLifecycle::restore(bool activated, std::optional<time_point> graceStart)
+{
+  // A disabled license is saved as not activated, so there's nothing more to restore.
+  m_activated = activated;
+  m_disabled = false;
+  m_graceStart = graceStart;
+}
+
+void LicenseLifecycle::activate()
+{
+  m_activated = true;
+  m_disabled = false;
+  m_graceStart.reset();
+}
+
+void LicenseLifecycle::checkSucceeded()
+{
+  m_graceStart.reset();
+}
+
+bool LicenseLifecycle::checkFailed()
+{
+  if (!isInGracePeriod()) {
+    m_graceStart = m_nowFunc();
+  }
+
+  if (isGracePeriodExpired()) {
+    disable();
+    return true;
+  }
+
+  return false;
+}
+
+void LicenseLifecycle::disable()
+{
+  // The serial key is kept, so activating again can restore the license.
+  m_activated = false;
+  m_disabled = true;
+  m_graceStart.reset();
+}
+
+bool LicenseLifecycle::isGracePeriodExpired() const
+{
+  if (!isInGracePeriod()) {
+    return false;
+  }
+  return isGracePeriodExpired(m_graceStart.value(), m_nowFunc(), m_gracePeriod);
+}
+
+bool LicenseLifecycle::isGracePeriodExpired(time_point graceStart, time_point now, seconds gracePeriod)
+{
+  return now - graceStart >= gracePeriod;
+}
+
+const char *LicenseLifecycle::stateName(State state)
+{
+  switch (state) {
+    using enum State;
+
+  case kUnactivated:
+    return "unactivated";
+  case kActive:
+    return "active";
+  case kExpiringSoon:
+    return "expiring soon";
+  case kGracePeriod:
+    return "grace period";
+  case kDisabled:
+    return "disabled";
+  case kExpired:
+    return "expired";
+  }
+
+  return "unknown";
+}
+
+} // namespace synergy::license
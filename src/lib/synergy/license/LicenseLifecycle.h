@@ -0,0 +1,106 @@
+/*
+ * Synergy -- mouse and keyboard sharing utility
+ * Copyright (C) 2026 Symless Ltd.
+ *
+ * This package is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * found in the file LICENSE that should have accompanied this file.
+ *
+ * This package is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include "License.h"
+#include "SerialKey.h"
+
+#include <chrono>
+#include <functional>
+#include <optional>
+
+namespace synergy::license {
+
+/**
+ * @brief The rules for how a license moves between activated, grace and disabled.
+ *
+ * Time only comes from the now function, so the same rules can be played over months
+ * of simulated time in a test, or follow the wall clock in the app.
+ *
+ * A failed remote check starts the grace period. Failing again once the grace period
+ * has passed disables the license, until it's activated again (e.g. after the customer
+ * pays). Expiry is taken from the serial key and wins over everything else.
+ */
+class LicenseLifecycle
+{
+  using system_clock = std::chrono::system_clock;
+  using time_point = system_clock::time_point;
+  using seconds = std::chrono::seconds;
+  using NowFunc = std::function<time_point()>;
+
+public:
+  enum class State
+  {
+    kUnactivated,
+    kActive,
+    kExpiringSoon,
+    kGracePeriod,
+    kDisabled,
+    kExpired
+  };
+
+  LicenseLifecycle(const SerialKey &serialKey, seconds gracePeriod, NowFunc nowFunc);
+
+  State state() const;
+  const License &license() const
+  {
+    return m_license;
+  }
+  bool isActivated() const
+  {
+    return m_activated;
+  }
+  std::optional<time_point> graceStart() const
+  {
+    return m_graceStart;
+  }
+
+  /**
+   * @brief Picks up where an earlier run (or another process) left off.
+   */
+  void restore(bool activated, std::optional<time_point> graceStart);
+
+  void activate();
+  void checkSucceeded();
+
+  /**
+   * @return True if the grace period had passed, so the license is now disabled.
+   */
+  bool checkFailed();
+
+  void disable();
+
+  bool isInGracePeriod() const
+  {
+    return m_graceStart.has_value();
+  }
+  bool isGracePeriodExpired() const;
+
+  static bool isGracePeriodExpired(time_point graceStart, time_point now, seconds gracePeriod);
+  static const char *stateName(State state);
+
+private:
+  License m_license;
+  seconds m_gracePeriod;
+  NowFunc m_nowFunc;
+  bool m_activated = false;
+  bool m_disabled = false;
+  std::optional<time_point> m_graceStart = std::nullopt;
+};
+
+} // namespace synergy::license
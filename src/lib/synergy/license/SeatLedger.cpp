@@ -0,0 +1,93 @@
+/*
+ * Synergy -- mouse and keyboard sharing utility
+ * Copyright (C) 2026 Symless Ltd.
+ *
+ * This package is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * found in the file LICENSE that should have accompanied this file.
+ *
+ * This package is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "SeatLedger.h"
+
+namespace synergy::license {
+
+SeatLedger::SeatLedger(std::optional<int> limit) : m_limit(limit.value_or(0))
+{
+}
+
+bool SeatLedger::tryAcquire()
+{
+  const auto limit = m_limit.load(std::memory_order_relaxed);
+  auto used = m_used.load(std::memory_order_relaxed);
+
+  // Only succeeds if nobody else took a seat in between, otherwise retry with the
+  // fresh count; the limit check is repeated so the last seat can't be taken twice.
+  do {
+    if (limit > 0 && used >= limit) {
+      m_rejected.fetch_add(1, std::memory_order_relaxed);
+      return false;
+    }
+  } while (!m_used.compare_exchange_weak(used, used + 1, std::memory_order_acq_rel, std::memory_order_relaxed));
+
+  m_accepted.fetch_add(1, std::memory_order_relaxed);
+  updatePeak(used + 1);
+  return true;
+}
+
+void SeatLedger::release()
+{
+  // Never go below zero, even if the caller releases a seat it didn't get.
+  auto used = m_used.load(std::memory_order_relaxed);
+  do {
+    if (used <= 0) {
+      return;
+    }
+  } while (!m_used.compare_exchange_weak(used, used - 1, std::memory_order_acq_rel, std::memory_order_relaxed));
+}
+
+void SeatLedger::setLimit(std::optional<int> limit)
+{
+  m_limit.store(limit.value_or(0), std::memory_order_relaxed);
+}
+
+void SeatLedger::clear()
+{
+  m_used.store(0, std::memory_order_relaxed);
+}
+
+int SeatLedger::restartPeak()
+{
+  // A seat taken in between raises the new peak itself, so none is missed.
+  const auto peak = m_peak.exchange(0, std::memory_order_relaxed);
+  updatePeak(m_used.load(std::memory_order_relaxed));
+  return peak;
+}
+
+SeatLedger::Snapshot SeatLedger::snapshot() const
+{
+  const auto limit = m_limit.load(std::memory_order_relaxed);
+  return {
+      m_used.load(std::memory_order_relaxed),
+      m_peak.load(std::memory_order_relaxed),
+      limit > 0 ? std::optional<int>(limit) : std::nullopt,
+      m_accepted.load(std::memory_order_relaxed),
+      m_rejected.load(std::memory_order_relaxed),
+  };
+}
+
+void SeatLedger::updatePeak(int used)
+{
+  auto peak = m_peak.load(std::memory_order_relaxed);
+  while (used > peak && !m_peak.compare_exchange_weak(peak, used, std::memory_order_relaxed)) {
+  }
+}
+
+} // namespace synergy::license
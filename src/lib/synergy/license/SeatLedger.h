@@ -0,0 +1,95 @@
+/*
+ * Synergy -- mouse and keyboard sharing utility
+ * Copyright (C) 2026 Symless Ltd.
+ *
+ * This package is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * found in the file LICENSE that should have accompanied this file.
+ *
+ * This package is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <optional>
+
+namespace synergy::license {
+
+/**
+ * @brief Counts the seats in use against the serial key's seat limit.
+ *
+ * The server calls `tryAcquire` when a client connects and `release` when an accepted
+ * client disconnects. All operations are lock-free and O(1), so a burst of reconnects
+ * (e.g. a whole floor coming back after a network outage) never queues behind a lock.
+ */
+class SeatLedger
+{
+public:
+  struct Snapshot
+  {
+    int used = 0;
+    int peak = 0;
+    std::optional<int> limit = std::nullopt;
+    std::uint64_t accepted = 0;
+    std::uint64_t rejected = 0;
+  };
+
+  explicit SeatLedger(std::optional<int> limit = std::nullopt);
+
+  /**
+   * @brief Takes a seat if one is free.
+   *
+   * @return False if the limit has been reached, in which case the client should be
+   *    rejected and must not call `release`.
+   */
+  bool tryAcquire();
+  void release();
+
+  /**
+   * @brief Changes the limit, e.g. when the serial key changes.
+   *
+   * Seats already taken are kept even if there are now more than the new limit;
+   * new clients are rejected until enough have disconnected.
+   */
+  void setLimit(std::optional<int> limit);
+
+  /**
+   * @brief Frees every seat, e.g. when the server stops and all clients are gone.
+   *
+   * The peak is kept, so seats used before the server stopped are still reported.
+   */
+  void clear();
+
+  /**
+   * @brief Returns the peak so far, and starts a new peak from the seats in use now.
+   */
+  int restartPeak();
+
+  /**
+   * @brief Reads the counters without stopping writers.
+   *
+   * Each field is read atomically, but not all together, so under heavy churn the
+   * fields may be from slightly different moments.
+   */
+  Snapshot snapshot() const;
+
+private:
+  void updatePeak(int used);
+
+  // Zero means no limit.
+  std::atomic_int m_limit;
+  std::atomic_int m_used = 0;
+  std::atomic_int m_peak = 0;
+  std::atomic_uint64_t m_accepted = 0;
+  std::atomic_uint64_t m_rejected = 0;
+};
+
+} // namespace synergy::license
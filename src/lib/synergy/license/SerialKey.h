@@ -34,7 +34,7 @@ struct SerialKey
   friend bool operator==(const SerialKey &lhs, const SerialKey &rhs)
   {
     return (lhs.hexString == rhs.hexString) && (lhs.warnTime == rhs.warnTime) && (lhs.expireTime == rhs.expireTime) &&
-           (lhs.product == rhs.product) && (lhs.type == rhs.type);
+           (lhs.product == rhs.product) && (lhs.type == rhs.type) && (lhs.seats == rhs.seats);
   }
 
   explicit SerialKey(const std::string &key) : hexString(key)
@@ -59,6 +59,9 @@ struct SerialKey
   std::optional<time_point> expireTime = std::nullopt;
   bool isOffline = false;
 
+  /// Number of machines the key may be used on at once, or none if not limited.
+  std::optional<int> seats = std::nullopt;
+
 private:
   explicit SerialKey(Product::Edition edition) : product(edition)
   {
@@ -39,6 +39,7 @@ SerialKey parseV1(const std::string &hexString, const Parts &parts);
 SerialKey parseV2(const std::string &hexString, const Parts &parts);
 SerialKey parseV3(const std::string &hexString, const Parts &parts);
 std::optional<time_point> parseDate(const std::string &unixTimeString);
+std::optional<int> parseSeats(const std::string &seatsString);
 
 SerialKey parseSerialKey(const std::string &hexString)
 {
@@ -85,6 +86,7 @@ SerialKey parseV1(const std::string &hexString, const Parts &parts)
   // e.g.: {v1;basic;name;seats;email;company;1398297600;1398384000}
   SerialKey serialKey(hexString);
   serialKey.product = Product(parts.at(1));
+  serialKey.seats = parseSeats(parts.at(3));
   serialKey.warnTime = parseDate(parts.at(6));
   serialKey.expireTime = parseDate(parts.at(7));
   serialKey.isValid = true;
@@ -100,6 +102,7 @@ SerialKey parseV2(const std::string &hexString, const Parts &parts)
   SerialKey serialKey(hexString);
   serialKey.type = SerialKeyType(parts.at(1));
   serialKey.product = Product(parts.at(2));
+  serialKey.seats = parseSeats(parts.at(4));
   serialKey.warnTime = parseDate(parts.at(7));
   serialKey.expireTime = parseDate(parts.at(8));
   serialKey.isValid = true;
@@ -116,6 +119,7 @@ SerialKey parseV3(const std::string &hexString, const Parts &parts)
   serialKey.isOffline = (parts.at(1) == "offline");
   serialKey.type = SerialKeyType(parts.at(2));
   serialKey.product = Product(parts.at(3));
+  serialKey.seats = parseSeats(parts.at(5));
   serialKey.warnTime = parseDate(parts.at(8));
   serialKey.expireTime = parseDate(parts.at(9));
   serialKey.isValid = true;
@@ -171,4 +175,25 @@ std::optional<time_point> parseDate(const std::string &unixTimeString)
   }
 }
 
+std::optional<int> parseSeats(const std::string &seatsString)
+{
+  // Older keys were issued with blank or free text seat fields, and they must keep
+  // working, so anything that isn't a positive count just means no limit.
+  auto clean = deskflow::utils::trim(seatsString);
+  if (clean.empty()) {
+    return std::nullopt;
+  }
+
+  try {
+    size_t end = 0;
+    const auto seats = std::stoi(clean, &end);
+    if (end != clean.length() || seats <= 0) {
+      return std::nullopt;
+    }
+    return seats;
+  } catch (std::exception &) {
+    return std::nullopt;
+  }
+}
+
 } // namespace synergy::license
@@ -0,0 +1,234 @@
+/*
+ * Synergy -- mouse and keyboard sharing utility
+ * Copyright (C) 2026 Symless Ltd.
+ *
+ * This package is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * found in the file LICENSE that should have accompanied this file.
+ *
+ * This package is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+// Measures the time from clicking start to the core starting, when the license still
+// needs activating, against a mock license API on localhost.
+//
+// Env vars:
+//  - SYNERGY_ACTIVATION_RUNS: how many activations to time (default 20).
+//  - SYNERGY_ACTIVATION_LATENCY_MS: simulated server latency (default 50).
+//  - SYNERGY_ACTIVATION_LATENCY_JSON: where to write the percentiles (default: log only).
+
+#include "gui/config/AppConfig.h"
+#include "gui/config/ConfigScopes.h"
+#include "gui/core/CoreProcess.h"
+#include "shared/gui/mocks/ServerConfigMock.h"
+#include "shared/license/LatencyStats.h"
+#include "shared/license/MockLicenseApi.h"
+#include "synergy/gui/ExtraSettings.h"
+#include "synergy/gui/license/ActivationTrace.h"
+#include "synergy/gui/license/LicenseHandler.h"
+
+#include <QApplication>
+#include <QEventLoop>
+#include <QFile>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QMainWindow>
+#include <QSettings>
+#include <QStandardPaths>
+#include <QTemporaryDir>
+#include <QTimer>
+
+#include <functional>
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+#include <memory>
+#include <optional>
+#include <vector>
+
+using namespace std::chrono;
+using namespace synergy::gui::license;
+using synergy::gui::ExtraSettings;
+using testing::NiceMock;
+
+// {v1;pro;nick bolton;1;nick@symless.com; ;0;0}
+const auto kSerialKey = "7B76313B70726F3B6E69636B20626F6C746F6E3B313B6"
+                        "E69636B4073796D6C6573732E636F6D3B203B303B307D";
+
+const auto kActivationTimeout = seconds{10};
+const auto kDefaultRuns = 20;
+const auto kDefaultServerLatencyMs = 50;
+
+struct Phase
+{
+  const char *name;
+  std::function<microseconds(const ActivationTrace &)> value;
+};
+
+const std::vector<Phase> kPhases = {
+    {"settingsLoad", [](const ActivationTrace &trace) { return trace.settingsLoad; }},
+    {"fingerprint", [](const ActivationTrace &trace) { return trace.fingerprint; }},
+    {"queue", [](const ActivationTrace &trace) { return trace.network.queue; }},
+    {"lookup", [](const ActivationTrace &trace) { return trace.network.lookup; }},
+    {"connect", [](const ActivationTrace &trace) { return trace.network.connect; }},
+    {"server", [](const ActivationTrace &trace) { return trace.network.server; }},
+    {"download", [](const ActivationTrace &trace) { return trace.network.download; }},
+    {"responseHandling", [](const ActivationTrace &trace) { return trace.responseHandling; }},
+    {"coreStart", [](const ActivationTrace &trace) { return trace.coreStart; }},
+    {"total", [](const ActivationTrace &trace) { return trace.total; }},
+};
+
+class ActivationLatencyTests : public testing::Test
+{
+protected:
+  // The widgets below need an app, and fixture members are created before `SetUp`.
+  static void SetUpTestSuite()
+  {
+    if (QCoreApplication::instance() == nullptr) {
+      static int argc = 1;
+      static char arg0[] = "integtests";
+      static char *argv[] = {arg0, nullptr};
+      s_app = std::make_unique<QApplication>(argc, argv);
+    }
+
+    // Never touch the settings, or license, of whoever runs the tests. Test mode moves
+    // the standard paths; the paths and names below also cover the settings formats and
+    // platforms (e.g. the Windows registry) that test mode doesn't.
+    QStandardPaths::setTestModeEnabled(true);
+    s_settingsDir = std::make_unique<QTemporaryDir>();
+    QSettings::setPath(QSettings::IniFormat, QSettings::UserScope, s_settingsDir->path());
+    QSettings::setPath(QSettings::NativeFormat, QSettings::UserScope, s_settingsDir->path());
+    QCoreApplication::setOrganizationName("SynergyTests");
+    QCoreApplication::setApplicationName("ActivationLatencyTests");
+  }
+
+  static void TearDownTestSuite()
+  {
+    s_settingsDir.reset();
+    QStandardPaths::setTestModeEnabled(false);
+    s_app.reset();
+  }
+
+  void SetUp() override
+  {
+    ASSERT_TRUE(m_api.listen());
+    MockLicenseApi::Behavior behavior;
+    behavior.latencyMs = m_serverLatencyMs;
+    m_api.setBehavior("activate", behavior);
+
+    qputenv("SYNERGY_ENABLE_ACTIVATION", "true");
+    qputenv("SYNERGY_TEST_API_URL_ACTIVATE", m_api.url("activate").toUtf8());
+    m_settings.load();
+  }
+
+  void TearDown() override
+  {
+    qunsetenv("SYNERGY_TEST_API_URL_ACTIVATE");
+    qunsetenv("SYNERGY_TEST_LICENSE_STATE_DIR");
+  }
+
+  // Each run is a fresh process as far as licensing knows: not activated, and nothing
+  // shared by earlier runs for the coordinator to reuse.
+  std::optional<ActivationTrace> runOnce()
+  {
+    m_settings.setSerialKey(kSerialKey);
+    m_settings.setActivated(false);
+    m_settings.setLease({});
+    m_settings.setGraceStartEpochSecs(0);
+    m_settings.sync();
+
+    QTemporaryDir stateDir;
+    qputenv("SYNERGY_TEST_LICENSE_STATE_DIR", stateDir.path().toUtf8());
+
+    std::optional<ActivationTrace> result;
+    QEventLoop loop;
+    QTimer::singleShot(kActivationTimeout, &loop, &QEventLoop::quit);
+
+    LicenseHandler handler;
+    QObject::connect(&handler, &LicenseHandler::activationTraced, &loop, [&result, &loop](const auto &trace) {
+      result = trace;
+      loop.quit();
+    });
+
+    handler.handleMainWindow(&m_mainWindow, &m_appConfig, &m_coreProcess);
+    if (handler.handleCoreStart()) {
+      ADD_FAILURE() << "core started without activating";
+      return std::nullopt;
+    }
+
+    loop.exec();
+    return result;
+  }
+
+  static std::unique_ptr<QApplication> s_app;
+  static std::unique_ptr<QTemporaryDir> s_settingsDir;
+
+  const int m_serverLatencyMs = qEnvironmentVariableIsSet("SYNERGY_ACTIVATION_LATENCY_MS")
+                                    ? qEnvironmentVariableIntValue("SYNERGY_ACTIVATION_LATENCY_MS")
+                                    : kDefaultServerLatencyMs;
+  MockLicenseApi m_api;
+  ExtraSettings m_settings;
+  QMainWindow m_mainWindow;
+  deskflow::gui::ConfigScopes m_scopes;
+  AppConfig m_appConfig{m_scopes};
+  NiceMock<deskflow::gui::ServerConfigMock> m_serverConfig;
+
+  // With no mode set, the core isn't launched, so core start only covers the handler's
+  // own work; launching the real core belongs in a test of its own.
+  deskflow::gui::CoreProcess m_coreProcess{m_appConfig, m_serverConfig};
+};
+
+std::unique_ptr<QApplication> ActivationLatencyTests::s_app;
+std::unique_ptr<QTemporaryDir> ActivationLatencyTests::s_settingsDir;
+
+TEST_F(ActivationLatencyTests, handleCoreStart_activation_reportsPhasePercentiles)
+{
+  const auto runs = qEnvironmentVariableIsSet("SYNERGY_ACTIVATION_RUNS")
+                        ? qEnvironmentVariableIntValue("SYNERGY_ACTIVATION_RUNS")
+                        : kDefaultRuns;
+
+  std::vector<LatencyStats> stats(kPhases.size());
+  QJsonArray traces;
+  for (int run = 0; run < runs; run++) {
+    const auto trace = runOnce();
+    ASSERT_TRUE(trace.has_value()) << "activation did not finish, run: " << run;
+
+    traces.append(trace->toJson());
+    for (std::size_t i = 0; i < kPhases.size(); i++) {
+      stats[i].add(kPhases[i].value(trace.value()));
+    }
+  }
+
+  QJsonObject phases;
+  for (std::size_t i = 0; i < kPhases.size(); i++) {
+    phases[kPhases[i].name] = QJsonObject{
+        {"p50Us", static_cast<qint64>(stats[i].percentile(50).count())},
+        {"p95Us", static_cast<qint64>(stats[i].percentile(95).count())},
+        {"p99Us", static_cast<qint64>(stats[i].percentile(99).count())},
+        {"meanUs", static_cast<qint64>(stats[i].mean().count())},
+    };
+  }
+
+  const QJsonObject report{
+      {"runs", runs},
+      {"serverLatencyMs", m_serverLatencyMs},
+      {"phases", phases},
+      {"traces", traces},
+  };
+  const auto json = QJsonDocument(report).toJson();
+  qInfo().noquote() << "activation latency:" << QJsonDocument(phases).toJson(QJsonDocument::Compact);
+
+  if (const auto path = qEnvironmentVariable("SYNERGY_ACTIVATION_LATENCY_JSON"); !path.isEmpty()) {
+    QFile file(path);
+    ASSERT_TRUE(file.open(QIODevice::WriteOnly | QIODevice::Truncate)) << path.toStdString();
+    file.write(json);
+  }
+
+  EXPECT_EQ(runs, static_cast<int>(m_api.stats().answered));
+  EXPECT_GT(stats.back().percentile(50), microseconds{0});
+}
@@ -0,0 +1,291 @@
+/*
+ * Synergy -- mouse and keyboard sharing utility
+ * Copyright (C) 2026 Symless Ltd.
+ *
+ * This package is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * found in the file LICENSE that should have accompanied this file.
+ *
+ * This package is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+// Drives the handler's optimistic start and background (speculative) activation against
+// a mock license API on localhost, checking what ends up saved.
+
+#include "gui/config/AppConfig.h"
+#include "gui/config/ConfigScopes.h"
+#include "gui/core/CoreProcess.h"
+#include "shared/gui/mocks/ServerConfigMock.h"
+#include "shared/license/MockLicenseApi.h"
+#include "synergy/gui/ExtraSettings.h"
+#include "synergy/gui/constants.h"
+#include "synergy/gui/license/LicenseHandler.h"
+
+#include <QApplication>
+#include <QDateTime>
+#include <QElapsedTimer>
+#include <QMainWindow>
+#include <QSettings>
+#include <QStandardPaths>
+#include <QTemporaryDir>
+
+#include <functional>
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+#include <memory>
+
+using namespace std::chrono;
+using namespace synergy::gui::license;
+using synergy::gui::ExtraSettings;
+using testing::NiceMock;
+
+// {v1;pro;nick bolton;1;nick@symless.com; ;0;0}
+const auto kSerialKey = "7B76313B70726F3B6E69636B20626F6C746F6E3B313B6"
+                        "E69636B4073796D6C6573732E636F6D3B203B303B307D";
+
+const auto kWaitTimeout = seconds{10};
+
+// Long enough for a reply on localhost to be handled once the mock has sent it.
+const auto kSettleTime = milliseconds{500};
+
+class ActivationStateTests : public testing::Test
+{
+protected:
+  static void SetUpTestSuite()
+  {
+    if (QCoreApplication::instance() == nullptr) {
+      static int argc = 1;
+      static char arg0[] = "integtests";
+      static char *argv[] = {arg0, nullptr};
+      s_app = std::make_unique<QApplication>(argc, argv);
+    }
+
+    // Never touch the settings, or license, of whoever runs the tests.
+    QStandardPaths::setTestModeEnabled(true);
+    s_settingsDir = std::make_unique<QTemporaryDir>();
+    QSettings::setPath(QSettings::IniFormat, QSettings::UserScope, s_settingsDir->path());
+    QSettings::setPath(QSettings::NativeFormat, QSettings::UserScope, s_settingsDir->path());
+    QCoreApplication::setOrganizationName("SynergyTests");
+    QCoreApplication::setApplicationName("ActivationStateTests");
+  }
+
+  static void TearDownTestSuite()
+  {
+    s_settingsDir.reset();
+    QStandardPaths::setTestModeEnabled(false);
+    s_app.reset();
+  }
+
+  void SetUp() override
+  {
+    ASSERT_TRUE(m_api.listen());
+    setActivateBehavior("success");
+
+    qputenv("SYNERGY_ENABLE_ACTIVATION", "true");
+    qputenv("SYNERGY_TEST_API_URL_ACTIVATE", m_api.url("activate").toUtf8());
+    qputenv("SYNERGY_TEST_LICENSE_STATE_DIR", m_stateDir.path().toUtf8());
+    qputenv("SYNERGY_TEST_ACTIVATION_RETRY_MS", "50");
+
+    m_settings.load();
+    m_settings.setSerialKey(kSerialKey);
+    m_settings.setActivated(false);
+    m_settings.setLease({});
+    m_settings.setGraceStartEpochSecs(0);
+    m_settings.sync();
+  }
+
+  void TearDown() override
+  {
+    m_handler.reset();
+
+    qunsetenv("SYNERGY_TEST_API_URL_ACTIVATE");
+    qunsetenv("SYNERGY_TEST_LICENSE_STATE_DIR");
+    qunsetenv("SYNERGY_TEST_ACTIVATION_RETRY_MS");
+    qunsetenv("SYNERGY_LICENSE_OPTIMISTIC_START");
+  }
+
+  void setActivateBehavior(const QString &status, int latencyMs = 0, double errorRate = 0)
+  {
+    MockLicenseApi::Behavior behavior;
+    behavior.status = status;
+    behavior.latencyMs = latencyMs;
+    behavior.errorRate = errorRate;
+    m_api.setBehavior("activate", behavior);
+  }
+
+  LicenseHandler &startHandler()
+  {
+    m_handler = std::make_unique<LicenseHandler>();
+    QObject::connect(m_handler.get(), &LicenseHandler::activationTraced, [this] { m_traced = true; });
+    m_handler->handleMainWindow(&m_mainWindow, &m_appConfig, &m_coreProcess);
+    return *m_handler;
+  }
+
+  // The handler saves its settings as it goes away, so this is what the next run sees.
+  void stopHandler()
+  {
+    m_handler.reset();
+    m_settings.load();
+  }
+
+  static bool waitFor(const std::function<bool()> &condition)
+  {
+    QElapsedTimer timer;
+    timer.start();
+    while (!condition()) {
+      if (timer.elapsed() > duration_cast<milliseconds>(kWaitTimeout).count()) {
+        return false;
+      }
+      QCoreApplication::processEvents(QEventLoop::AllEvents, 10);
+    }
+    return true;
+  }
+
+  static void settle()
+  {
+    QElapsedTimer timer;
+    timer.start();
+    waitFor([&timer] { return timer.elapsed() > kSettleTime.count(); });
+  }
+
+  static std::unique_ptr<QApplication> s_app;
+  static std::unique_ptr<QTemporaryDir> s_settingsDir;
+
+  QTemporaryDir m_stateDir;
+  MockLicenseApi m_api;
+  ExtraSettings m_settings;
+  QMainWindow m_mainWindow;
+  deskflow::gui::ConfigScopes m_scopes;
+  AppConfig m_appConfig{m_scopes};
+  NiceMock<deskflow::gui::ServerConfigMock> m_serverConfig;
+
+  // With no mode set, the core is never launched, so only the handler's decisions are tested.
+  deskflow::gui::CoreProcess m_coreProcess{m_appConfig, m_serverConfig};
+  std::unique_ptr<LicenseHandler> m_handler;
+  bool m_traced = false;
+};
+
+std::unique_ptr<QApplication> ActivationStateTests::s_app;
+std::unique_ptr<QTemporaryDir> ActivationStateTests::s_settingsDir;
+
+class OptimisticStartTests : public ActivationStateTests
+{
+protected:
+  void SetUp() override
+  {
+#ifdef NDEBUG
+    GTEST_SKIP() << "optimistic start can only be forced by env var in debug builds";
+#endif // NDEBUG
+
+    ActivationStateTests::SetUp();
+    qputenv("SYNERGY_LICENSE_OPTIMISTIC_START", "true");
+  }
+};
+
+TEST_F(ActivationStateTests, handleAppStart_validKey_activatesInBackground)
+{
+  auto &handler = startHandler();
+
+  ASSERT_TRUE(handler.handleAppStart());
+  ASSERT_TRUE(waitFor([this] { return m_api.stats().answered == 1; }));
+  settle();
+
+  EXPECT_TRUE(handler.handleCoreStart());
+  EXPECT_EQ(1U, m_api.stats().requests);
+}
+
+TEST_F(ActivationStateTests, handleCoreStart_backgroundActivationInFlight_takesItOver)
+{
+  setActivateBehavior("success", 300);
+  auto &handler = startHandler();
+  ASSERT_TRUE(handler.handleAppStart());
+  ASSERT_TRUE(waitFor([this] { return m_api.stats().requests == 1; }));
+
+  EXPECT_FALSE(handler.handleCoreStart());
+  ASSERT_TRUE(waitFor([this] { return m_traced; }));
+
+  EXPECT_EQ(1U, m_api.stats().requests);
+  stopHandler();
+  EXPECT_TRUE(m_settings.activated());
+}
+
+TEST_F(ActivationStateTests, handleCoreStart_backgroundNetworkError_activatesAgain)
+{
+  setActivateBehavior("success", 0, 1);
+  auto &handler = startHandler();
+  ASSERT_TRUE(handler.handleAppStart());
+  ASSERT_TRUE(waitFor([this] { return m_api.stats().errors == 1; }));
+  settle();
+  setActivateBehavior("success");
+
+  EXPECT_FALSE(handler.handleCoreStart());
+  ASSERT_TRUE(waitFor([this] { return m_traced; }));
+
+  EXPECT_EQ(2U, m_api.stats().requests);
+  stopHandler();
+  EXPECT_TRUE(m_settings.activated());
+}
+
+TEST_F(OptimisticStartTests, handleCoreStart_optimistic_startsBeforeActivationFinishes)
+{
+  setActivateBehavior("success", 300);
+  auto &handler = startHandler();
+
+  EXPECT_TRUE(handler.handleCoreStart());
+  EXPECT_EQ(0U, m_api.stats().answered);
+  ASSERT_TRUE(waitFor([this] { return m_traced; }));
+
+  stopHandler();
+  EXPECT_TRUE(m_settings.activated());
+  EXPECT_EQ(0, m_settings.graceStartEpochSecs());
+}
+
+TEST_F(OptimisticStartTests, handleCoreStart_optimisticNetworkError_startsGracePeriod)
+{
+  setActivateBehavior("success", 0, 1);
+  auto &handler = startHandler();
+
+  EXPECT_TRUE(handler.handleCoreStart());
+  ASSERT_TRUE(waitFor([this] { return m_traced; }));
+
+  stopHandler();
+  EXPECT_FALSE(m_settings.activated());
+  EXPECT_GT(m_settings.graceStartEpochSecs(), 0);
+}
+
+TEST_F(OptimisticStartTests, handleCoreStart_optimisticNetworkError_activatesOnceReachable)
+{
+  setActivateBehavior("success", 0, 1);
+  auto &handler = startHandler();
+  EXPECT_TRUE(handler.handleCoreStart());
+  ASSERT_TRUE(waitFor([this] { return m_traced; }));
+
+  setActivateBehavior("success");
+  ASSERT_TRUE(waitFor([this] { return m_api.stats().answered == 1; }));
+  settle();
+
+  stopHandler();
+  EXPECT_TRUE(m_settings.activated());
+  EXPECT_EQ(0, m_settings.graceStartEpochSecs());
+}
+
+TEST_F(OptimisticStartTests, handleCoreStart_gracePeriodOver_waitsForActivation)
+{
+  const auto graceOver = duration_cast<seconds>(synergy::gui::kLicenseGracePeriod + days{1});
+  m_settings.setGraceStartEpochSecs(QDateTime::currentSecsSinceEpoch() - graceOver.count());
+  m_settings.sync();
+  auto &handler = startHandler();
+
+  EXPECT_FALSE(handler.handleCoreStart());
+  ASSERT_TRUE(waitFor([this] { return m_traced; }));
+
+  stopHandler();
+  EXPECT_TRUE(m_settings.activated());
+  EXPECT_EQ(0, m_settings.graceStartEpochSecs());
+}
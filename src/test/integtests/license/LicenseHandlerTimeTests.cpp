@@ -0,0 +1,121 @@
+/*
+ * Synergy -- mouse and keyboard sharing utility
+ * Copyright (C) 2026 Symless Ltd.
+ *
+ * This package is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * found in the file LICENSE that should have accompanied this file.
+ *
+ * This package is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+// Runs a real handler on a virtual clock, so a trial's warn and expiry play out at once.
+
+#include "shared/license/VirtualClock.h"
+#include "synergy/gui/AppTime.h"
+#include "synergy/gui/license/LicenseHandler.h"
+
+#include <QApplication>
+#include <QSettings>
+#include <QStandardPaths>
+#include <QTemporaryDir>
+
+#include <chrono>
+#include <gtest/gtest.h>
+#include <memory>
+
+using namespace std::chrono;
+using synergy::gui::AppTime;
+using synergy::license::VirtualClock;
+using SetSerialKeyResult = LicenseHandler::SetSerialKeyResult;
+
+const auto kStart = system_clock::time_point{days{20000}};
+const auto kWarnAfter = days{20};
+const auto kExpireAfter = days{30};
+
+class LicenseHandlerTimeTests : public testing::Test
+{
+protected:
+  static void SetUpTestSuite()
+  {
+    if (QCoreApplication::instance() == nullptr) {
+      static int argc = 1;
+      static char arg0[] = "integtests";
+      static char *argv[] = {arg0, nullptr};
+      s_app = std::make_unique<QApplication>(argc, argv);
+    }
+
+    // Never touch the settings, or license, of whoever runs the tests.
+    QStandardPaths::setTestModeEnabled(true);
+    s_settingsDir = std::make_unique<QTemporaryDir>();
+    QSettings::setPath(QSettings::IniFormat, QSettings::UserScope, s_settingsDir->path());
+    QSettings::setPath(QSettings::NativeFormat, QSettings::UserScope, s_settingsDir->path());
+    QCoreApplication::setOrganizationName("SynergyTests");
+    QCoreApplication::setApplicationName("LicenseHandlerTimeTests");
+  }
+
+  static void TearDownTestSuite()
+  {
+    s_settingsDir.reset();
+    QStandardPaths::setTestModeEnabled(false);
+    s_app.reset();
+  }
+
+  void SetUp() override
+  {
+    AppTime::setVirtualClock([this] { return m_clock.now(); });
+    m_handler = std::make_unique<LicenseHandler>();
+  }
+
+  void TearDown() override
+  {
+    m_handler.reset();
+    AppTime::setVirtualClock({});
+  }
+
+  // A trial that warns and expires a fixed time after the simulation starts.
+  static QString trialSerialKey()
+  {
+    const auto epochSecs = [](system_clock::time_point at) {
+      return QString::number(duration_cast<seconds>(at.time_since_epoch()).count());
+    };
+    const auto plainText = QString("{v2;trial;pro;test;1;test@example.com; ;%1;%2}")
+                               .arg(epochSecs(kStart + kWarnAfter), epochSecs(kStart + kExpireAfter));
+    return QString::fromLatin1(plainText.toLatin1().toHex().toUpper());
+  }
+
+  static std::unique_ptr<QApplication> s_app;
+  static std::unique_ptr<QTemporaryDir> s_settingsDir;
+
+  VirtualClock m_clock{kStart};
+  std::unique_ptr<LicenseHandler> m_handler;
+};
+
+std::unique_ptr<QApplication> LicenseHandlerTimeTests::s_app;
+std::unique_ptr<QTemporaryDir> LicenseHandlerTimeTests::s_settingsDir;
+
+TEST_F(LicenseHandlerTimeTests, setLicense_trial_warnsThenExpiresOnVirtualTime)
+{
+  ASSERT_EQ(m_handler->setLicense(trialSerialKey()), SetSerialKeyResult::kSuccess);
+  EXPECT_FALSE(m_handler->license().isExpiringSoon());
+
+  m_clock.runFor(kWarnAfter + days{1});
+  EXPECT_TRUE(m_handler->license().isExpiringSoon());
+  EXPECT_FALSE(m_handler->license().isExpired());
+
+  m_clock.runFor(kExpireAfter - kWarnAfter);
+  EXPECT_TRUE(m_handler->license().isExpired());
+  EXPECT_EQ(m_handler->license().daysLeft(), days{-1});
+}
+
+TEST_F(LicenseHandlerTimeTests, setLicense_trialExpiredOnVirtualTime_rejected)
+{
+  m_clock.runFor(kExpireAfter + days{1});
+
+  EXPECT_EQ(m_handler->setLicense(trialSerialKey()), SetSerialKeyResult::kExpired);
+}
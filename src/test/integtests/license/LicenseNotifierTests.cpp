@@ -0,0 +1,124 @@
+/*
+ * Synergy -- mouse and keyboard sharing utility
+ * Copyright (C) 2026 Symless Ltd.
+ *
+ * This package is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * found in the file LICENSE that should have accompanied this file.
+ *
+ * This package is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+// Shows notices over a real window, checking which text ends up on screen.
+
+#include "synergy/gui/license/LicenseNotifier.h"
+
+#include <QApplication>
+#include <QMessageBox>
+#include <QWidget>
+
+#include <functional>
+#include <gtest/gtest.h>
+#include <memory>
+
+using namespace synergy::gui::license;
+
+class LicenseNotifierTests : public testing::Test
+{
+protected:
+  static void SetUpTestSuite()
+  {
+    if (QCoreApplication::instance() == nullptr) {
+      static int argc = 1;
+      static char arg0[] = "integtests";
+      static char *argv[] = {arg0, nullptr};
+      s_app = std::make_unique<QApplication>(argc, argv);
+    }
+  }
+
+  static void TearDownTestSuite()
+  {
+    s_app.reset();
+  }
+
+  void SetUp() override
+  {
+    m_notifier.setParentWidget(&m_window);
+  }
+
+  QMessageBox *shown(const QString &key) const
+  {
+    return m_notifier.m_shown.value(key);
+  }
+
+  void post(const QString &message, std::function<void()> dismissed = {})
+  {
+    m_notifier.post("status", LicenseNotifier::Level::kWarning, "License check failed", message, dismissed);
+  }
+
+  static std::unique_ptr<QApplication> s_app;
+  QWidget m_window;
+  LicenseNotifier m_notifier;
+};
+
+std::unique_ptr<QApplication> LicenseNotifierTests::s_app;
+
+TEST_F(LicenseNotifierTests, post_manyBeforeShown_latestTextShown)
+{
+  post("first");
+  post("second");
+  post("third");
+  QCoreApplication::processEvents();
+
+  ASSERT_NE(nullptr, shown("status"));
+  EXPECT_EQ("third", shown("status")->text());
+  EXPECT_EQ(1, m_window.findChildren<QMessageBox *>().size());
+}
+
+TEST_F(LicenseNotifierTests, post_whileShown_sameBoxUpdated)
+{
+  post("first");
+  QCoreApplication::processEvents();
+  const auto box = shown("status");
+  ASSERT_NE(nullptr, box);
+  ASSERT_TRUE(box->isVisible());
+
+  post("second");
+  QCoreApplication::processEvents();
+
+  EXPECT_EQ(box, shown("status"));
+  EXPECT_EQ("second", box->text());
+  EXPECT_EQ(1, m_window.findChildren<QMessageBox *>().size());
+}
+
+TEST_F(LicenseNotifierTests, post_withDismissed_calledOnceAfterClose)
+{
+  auto calls = 0;
+  post("first", [&calls] { calls++; });
+  QCoreApplication::processEvents();
+  ASSERT_NE(nullptr, shown("status"));
+
+  EXPECT_EQ(0, calls);
+
+  shown("status")->done(QMessageBox::Ok);
+  QCoreApplication::processEvents();
+
+  EXPECT_EQ(1, calls);
+}
+
+TEST_F(LicenseNotifierTests, post_noWindow_dismissedCalled)
+{
+  m_notifier.setParentWidget(nullptr);
+  auto calls = 0;
+  post("first", [&calls] { calls++; });
+  QCoreApplication::processEvents();
+
+  EXPECT_EQ(1, calls);
+  EXPECT_EQ(nullptr, shown("status"));
+}
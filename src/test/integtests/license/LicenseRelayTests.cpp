@@ -0,0 +1,288 @@
+/*
+ * Synergy -- mouse and keyboard sharing utility
+ * Copyright (C) 2026 Symless Ltd.
+ *
+ * This package is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * found in the file LICENSE that should have accompanied this file.
+ *
+ * This package is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+// Talks to the license relay, and the HTTP server under it, over real sockets on
+// localhost, with a fake upstream in place of the license API.
+
+#include "shared/license/TestLeaseSigner.h"
+#include "synergy/gui/license/LicenseLease.h"
+#include "synergy/gui/license/LicenseRelay.h"
+#include "synergy/gui/license/LocalHttpServer.h"
+#include "synergy/gui/license/license_wire.h"
+
+#include <QCoreApplication>
+#include <QDateTime>
+#include <QElapsedTimer>
+#include <QEventLoop>
+#include <QPromise>
+#include <QTcpSocket>
+#include <QTimer>
+
+#include <gtest/gtest.h>
+#include <memory>
+#include <vector>
+
+using namespace std::chrono;
+using namespace synergy::gui::license;
+
+namespace {
+
+using Data = LicenseApiClient::Data;
+using Result = LicenseApiClient::Result;
+
+const auto kSerialKey = QStringLiteral("7B76313B70726F3B7D");
+const auto kResponseTimeout = seconds{5};
+const auto kLeaseLifetimeSecs = 3600;
+
+struct Response
+{
+  int code = 0;
+  QCborMap body;
+};
+
+// Sends the raw requests at once, and collects what comes back until the server hangs up.
+QList<QByteArray> exchange(quint16 port, const QList<QByteArray> &requests)
+{
+  std::vector<std::unique_ptr<QTcpSocket>> sockets;
+  QList<QByteArray> received(requests.size());
+  auto open = requests.size();
+
+  QEventLoop loop;
+  QTimer::singleShot(kResponseTimeout, &loop, &QEventLoop::quit);
+  for (qsizetype i = 0; i < requests.size(); i++) {
+    auto socket = sockets.emplace_back(std::make_unique<QTcpSocket>()).get();
+    QObject::connect(socket, &QTcpSocket::connected, [socket, request = requests[i]] { socket->write(request); });
+    QObject::connect(socket, &QTcpSocket::readyRead, [socket, &received, i] { received[i] += socket->readAll(); });
+    QObject::connect(socket, &QTcpSocket::disconnected, &loop, [&open, &loop] {
+      if (--open == 0) {
+        loop.quit();
+      }
+    });
+    socket->connectToHost(QHostAddress::LocalHost, port);
+  }
+
+  loop.exec();
+  return received;
+}
+
+QByteArray exchange(quint16 port, const QByteArray &request)
+{
+  return exchange(port, QList<QByteArray>{request}).first();
+}
+
+QByteArray post(const QByteArray &body, const QByteArray &contentLength = {})
+{
+  const auto length = contentLength.isEmpty() ? QByteArray::number(body.size()) : contentLength;
+  return "POST /product/check HTTP/1.1\r\nContent-Type: application/json\r\nContent-Length: " + length + "\r\n\r\n" +
+         body;
+}
+
+Response parse(const QByteArray &raw)
+{
+  Response response;
+  const auto statusLine = raw.left(raw.indexOf("\r\n")).split(' ');
+  if (statusLine.size() >= 2) {
+    response.code = statusLine[1].toInt();
+  }
+  if (const auto headerEnd = raw.indexOf("\r\n\r\n"); headerEnd >= 0) {
+    response.body = decodeMessage(raw.mid(headerEnd + 4), WireFormat::kJson);
+  }
+  return response;
+}
+
+QByteArray checkRequest(const QString &machineSignature)
+{
+  QCborMap message;
+  message[QStringLiteral("serialKey")] = kSerialKey;
+  message[QStringLiteral("machineSignature")] = machineSignature;
+  return post(encodeMessage(message, WireFormat::kJson));
+}
+
+QFuture<Result> readyFuture(const Result &result)
+{
+  QPromise<Result> promise;
+  promise.start();
+  promise.addResult(result);
+  promise.finish();
+  return promise.future();
+}
+
+} // namespace
+
+class LicenseRelayTests : public testing::Test
+{
+protected:
+  static void SetUpTestSuite()
+  {
+    if (QCoreApplication::instance() == nullptr) {
+      static int argc = 1;
+      static char arg0[] = "integtests";
+      static char *argv[] = {arg0, nullptr};
+      s_app = std::make_unique<QCoreApplication>(argc, argv);
+    }
+  }
+
+  static void TearDownTestSuite()
+  {
+    s_app.reset();
+  }
+
+  void SetUp() override
+  {
+#ifdef NDEBUG
+    GTEST_SKIP() << "lease public key can only be overridden by env var in debug builds";
+#endif // NDEBUG
+
+    qputenv("SYNERGY_TEST_LEASE_PUBLIC_KEY", m_signer.publicKey().toBase64());
+    m_relay.setBatchInterval(milliseconds{50});
+    ASSERT_TRUE(m_relay.listen(QHostAddress::LocalHost, 0));
+  }
+
+  void TearDown() override
+  {
+    qunsetenv("SYNERGY_TEST_LEASE_PUBLIC_KEY");
+  }
+
+  // Answers like the license API would: a lease signed for whichever machine asked.
+  QFuture<Result> upstream(const Data &data)
+  {
+    m_upstreamRequests++;
+    Result result;
+    result.status = m_upstreamStatus;
+    if (result.status == Result::Status::kSuccess) {
+      const auto now = QDateTime::currentSecsSinceEpoch();
+      result.lease = m_upstreamSigner->lease(data.serialKey, data.machineSignature, now, now + kLeaseLifetimeSecs);
+    }
+    return readyFuture(result);
+  }
+
+  bool hasLeaseFor(const Response &response, const QString &machineSignature) const
+  {
+    const auto token = response.body.value(QStringLiteral("lease")).toString();
+    const auto lease = LicenseLease::fromToken(token, m_signer.publicKey());
+    return lease.has_value() && lease->isValidFor(kSerialKey, machineSignature, QDateTime::currentSecsSinceEpoch());
+  }
+
+  static std::unique_ptr<QCoreApplication> s_app;
+
+  TestLeaseSigner m_signer;
+  const TestLeaseSigner *m_upstreamSigner = &m_signer;
+  Result::Status m_upstreamStatus = Result::Status::kSuccess;
+  int m_upstreamRequests = 0;
+  LicenseRelay m_relay{[this](const Data &data) { return upstream(data); }};
+};
+
+std::unique_ptr<QCoreApplication> LicenseRelayTests::s_app;
+
+TEST_F(LicenseRelayTests, check_sameMachineTogether_oneUpstreamRequest)
+{
+  const auto responses = exchange(m_relay.port(), {checkRequest("machine-a"), checkRequest("machine-a")});
+
+  EXPECT_EQ(1, m_upstreamRequests);
+  for (const auto &raw : responses) {
+    const auto response = parse(raw);
+    EXPECT_EQ(200, response.code);
+    EXPECT_TRUE(hasLeaseFor(response, "machine-a"));
+  }
+}
+
+TEST_F(LicenseRelayTests, check_otherMachinesTogether_eachGetsOwnLease)
+{
+  const auto responses = exchange(m_relay.port(), {checkRequest("machine-a"), checkRequest("machine-b")});
+
+  EXPECT_EQ(2, m_upstreamRequests);
+  EXPECT_TRUE(hasLeaseFor(parse(responses[0]), "machine-a"));
+  EXPECT_TRUE(hasLeaseFor(parse(responses[1]), "machine-b"));
+}
+
+TEST_F(LicenseRelayTests, check_askedAgain_answeredFromCache)
+{
+  exchange(m_relay.port(), checkRequest("machine-a"));
+
+  const auto response = parse(exchange(m_relay.port(), checkRequest("machine-a")));
+
+  EXPECT_EQ(1, m_upstreamRequests);
+  EXPECT_TRUE(hasLeaseFor(response, "machine-a"));
+}
+
+TEST_F(LicenseRelayTests, check_upstreamDisabled_badGateway)
+{
+  m_upstreamStatus = Result::Status::kDisabled;
+
+  const auto response = parse(exchange(m_relay.port(), checkRequest("machine-a")));
+
+  EXPECT_EQ(502, response.code);
+  EXPECT_TRUE(response.body.isEmpty());
+}
+
+TEST_F(LicenseRelayTests, check_leaseSignedByOtherKey_badGateway)
+{
+  const TestLeaseSigner forger;
+  m_upstreamSigner = &forger;
+
+  const auto response = parse(exchange(m_relay.port(), checkRequest("machine-a")));
+
+  EXPECT_EQ(502, response.code);
+}
+
+TEST_F(LicenseRelayTests, check_negativeContentLength_badRequest)
+{
+  const auto response = parse(exchange(m_relay.port(), post("{}", "-5")));
+
+  EXPECT_EQ(400, response.code);
+  EXPECT_EQ(0, m_upstreamRequests);
+}
+
+TEST_F(LicenseRelayTests, check_hugeContentLength_tooLarge)
+{
+  const auto response = parse(exchange(m_relay.port(), post("{}", "1000000000")));
+
+  EXPECT_EQ(413, response.code);
+}
+
+TEST_F(LicenseRelayTests, listen_noAddress_false)
+{
+  LicenseRelay relay([this](const Data &data) { return upstream(data); });
+
+  EXPECT_FALSE(relay.listen(LicenseRelay::listenAddress(""), 0));
+  EXPECT_FALSE(relay.isListening());
+}
+
+TEST_F(LicenseRelayTests, listenAddress_envVar_overridesSetting)
+{
+  qputenv("SYNERGY_LICENSE_RELAY_ADDRESS", "127.0.0.1");
+
+  EXPECT_EQ(QHostAddress(QHostAddress::LocalHost), LicenseRelay::listenAddress("192.168.1.10"));
+
+  qunsetenv("SYNERGY_LICENSE_RELAY_ADDRESS");
+}
+
+TEST_F(LicenseRelayTests, localHttpServer_slowRequest_closedAfterTimeout)
+{
+  LocalHttpServer http([](const LocalHttpServer::Request &, QTcpSocket *socket) {
+    LocalHttpServer::respond(socket, 200, {}, {});
+  });
+  http.setReadTimeout(milliseconds{100});
+  ASSERT_TRUE(http.listen(QHostAddress::LocalHost, 0));
+
+  QElapsedTimer timer;
+  timer.start();
+  const auto received = exchange(http.port(), QByteArray("POST /product/check HTTP/1.1\r\n"));
+
+  EXPECT_TRUE(received.isEmpty());
+  EXPECT_LT(timer.elapsed(), duration_cast<milliseconds>(kResponseTimeout).count());
+}
@@ -0,0 +1,118 @@
+/*
+ * Synergy -- mouse and keyboard sharing utility
+ * Copyright (C) 2026 Symless Ltd.
+ *
+ * This package is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * found in the file LICENSE that should have accompanied this file.
+ *
+ * This package is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+// Sends seat heartbeats through a fake API whose answers the test decides when to give.
+
+#include "synergy/gui/constants.h"
+#include "synergy/gui/license/SeatUsageReporter.h"
+
+#include <QCoreApplication>
+#include <QFile>
+#include <QPromise>
+#include <QTemporaryDir>
+
+#include <gtest/gtest.h>
+#include <memory>
+
+using namespace synergy::gui;
+using namespace synergy::gui::license;
+using Result = LicenseApiClient::Result;
+
+class SeatUsageReporterTests : public testing::Test
+{
+protected:
+  static void SetUpTestSuite()
+  {
+    if (QCoreApplication::instance() == nullptr) {
+      static int argc = 1;
+      static char arg0[] = "integtests";
+      static char *argv[] = {arg0, nullptr};
+      s_app = std::make_unique<QCoreApplication>(argc, argv);
+    }
+  }
+
+  static void TearDownTestSuite()
+  {
+    s_app.reset();
+  }
+
+  QString bufferPath() const
+  {
+    return m_dir.filePath("seat-heartbeats.jsonl");
+  }
+
+  void writeLines(int count) const
+  {
+    QFile file(bufferPath());
+    ASSERT_TRUE(file.open(QIODevice::WriteOnly));
+    for (auto i = 0; i < count; i++) {
+      file.write(QString(R"({"old":%1})").arg(i).toUtf8() + "\n");
+    }
+  }
+
+  void answer(Result::Status status)
+  {
+    Result result;
+    result.status = status;
+    m_promise->addResult(result);
+    m_promise->finish();
+    QCoreApplication::processEvents();
+  }
+
+  static std::unique_ptr<QCoreApplication> s_app;
+  QTemporaryDir m_dir;
+  std::shared_ptr<QPromise<Result>> m_promise;
+  SeatUsageReporter m_reporter{
+      [this](const QCborArray &) {
+        m_promise = std::make_shared<QPromise<Result>>();
+        m_promise->start();
+        return m_promise->future();
+      },
+      bufferPath()
+  };
+};
+
+std::unique_ptr<QCoreApplication> SeatUsageReporterTests::s_app;
+
+TEST_F(SeatUsageReporterTests, sendBuffered_trimmedWhileSending_keepsUnsent)
+{
+  writeLines(kMaxBufferedSeatHeartbeats);
+  m_reporter.sendBuffered();
+  ASSERT_NE(nullptr, m_promise);
+
+  // The buffer is full, so queueing drops the oldest line, which is one being sent.
+  m_reporter.queueHeartbeat();
+  answer(Result::Status::kSuccess);
+
+  const auto lines = m_reporter.readBuffer();
+  ASSERT_EQ(1, lines.size());
+  EXPECT_TRUE(lines.first().contains("current"));
+}
+
+TEST_F(SeatUsageReporterTests, sendBuffered_queuedWhileSending_keepsQueued)
+{
+  writeLines(3);
+  m_reporter.sendBuffered();
+  ASSERT_NE(nullptr, m_promise);
+
+  m_reporter.queueHeartbeat();
+  answer(Result::Status::kSuccess);
+
+  const auto lines = m_reporter.readBuffer();
+  ASSERT_EQ(1, lines.size());
+  EXPECT_TRUE(lines.first().contains("current"));
+}
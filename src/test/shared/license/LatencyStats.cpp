@@ -0,0 +1,62 @@
+/*
+ * Synergy -- mouse and keyboard sharing utility
+ * Copyright (C) 2026 Symless Ltd.
+ *
+ * This package is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * found in the file LICENSE that should have accompanied this file.
+ *
+ * This package is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "LatencyStats.h"
+
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+
+namespace synergy::gui::license {
+
+void LatencyStats::add(microseconds sample)
+{
+  m_samples.push_back(sample.count());
+}
+
+void LatencyStats::clear()
+{
+  m_samples.clear();
+}
+
+LatencyStats::microseconds LatencyStats::percentile(double percentile) const
+{
+  if (m_samples.empty()) {
+    return microseconds{0};
+  }
+
+  const auto clamped = std::clamp(percentile, 0.0, 100.0);
+  const auto rank = static_cast<std::size_t>(std::ceil(clamped / 100.0 * static_cast<double>(m_samples.size())));
+  const auto index = rank == 0 ? 0 : rank - 1;
+
+  // Partial sort of a copy; cheaper than a full sort for the handful of percentiles needed.
+  auto samples = m_samples;
+  std::nth_element(samples.begin(), samples.begin() + static_cast<std::ptrdiff_t>(index), samples.end());
+  return microseconds{samples[index]};
+}
+
+LatencyStats::microseconds LatencyStats::mean() const
+{
+  if (m_samples.empty()) {
+    return microseconds{0};
+  }
+
+  const auto total = std::accumulate(m_samples.cbegin(), m_samples.cend(), microseconds::rep{0});
+  return microseconds{total / static_cast<microseconds::rep>(m_samples.size())};
+}
+
+} // namespace synergy::gui::license
@@ -0,0 +1,52 @@
+/*
+ * Synergy -- mouse and keyboard sharing utility
+ * Copyright (C) 2026 Symless Ltd.
+ *
+ * This package is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * found in the file LICENSE that should have accompanied this file.
+ *
+ * This package is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <chrono>
+#include <vector>
+
+namespace synergy::gui::license {
+
+/**
+ * @brief Collects latency samples and reports percentiles, for load and timing tests.
+ */
+class LatencyStats
+{
+public:
+  using microseconds = std::chrono::microseconds;
+
+  void add(microseconds sample);
+  void clear();
+
+  std::size_t count() const
+  {
+    return m_samples.size();
+  }
+
+  /**
+   * @param percentile 0 to 100, using the nearest rank (so p100 is the max).
+   * @return Zero when there are no samples.
+   */
+  microseconds percentile(double percentile) const;
+  microseconds mean() const;
+
+private:
+  std::vector<microseconds::rep> m_samples;
+};
+
+} // namespace synergy::gui::license
@@ -0,0 +1,142 @@
+/*
+ * Synergy -- mouse and keyboard sharing utility
+ * Copyright (C) 2026 Symless Ltd.
+ *
+ * This package is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * found in the file LICENSE that should have accompanied this file.
+ *
+ * This package is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "LicenseSimulator.h"
+
+namespace synergy::license {
+
+LicenseSimulator::LicenseSimulator(VirtualClock &clock, Options options, Server server)
+    : m_clock(clock),
+      m_options(options),
+      m_server(std::move(server))
+{
+}
+
+std::size_t LicenseSimulator::add(const SerialKey &serialKey)
+{
+  const auto license = m_licenses.size();
+  auto &simulated = m_licenses.emplace_back(serialKey, m_options.gracePeriod, [this] { return m_clock.now(); });
+  simulated.last = simulated.lifecycle.state();
+
+  m_clock.scheduleAfter({}, [this, license] { activate(license); });
+
+  // Nothing else happens at these times, so without these the warn and expire
+  // transitions would only show up at the next request.
+  for (const auto &time : {serialKey.warnTime, serialKey.expireTime}) {
+    if (time.has_value()) {
+      m_clock.schedule(time.value(), [this, license] { record(license); });
+    }
+  }
+
+  return license;
+}
+
+std::vector<LicenseSimulator::Transition> LicenseSimulator::transitionsOf(std::size_t license) const
+{
+  std::vector<Transition> result;
+  for (const auto &transition : m_transitions) {
+    if (transition.license == license) {
+      result.push_back(transition);
+    }
+  }
+  return result;
+}
+
+void LicenseSimulator::activate(std::size_t license)
+{
+  auto &lifecycle = m_licenses.at(license).lifecycle;
+  if (lifecycle.state() == State::kExpired) {
+    return;
+  }
+
+  switch (request(license)) {
+    using enum Response;
+
+  case kSuccess:
+    lifecycle.activate();
+    record(license);
+
+    // Personal licenses are never checked again once activated.
+    if (lifecycle.license().productEdition() == Product::Edition::kBusiness) {
+      m_clock.scheduleAfter(m_options.checkInterval, [this, license] { check(license); });
+    }
+    return;
+
+  case kDisabled:
+    lifecycle.disable();
+    break;
+
+  case kFailed:
+    break;
+  }
+
+  record(license);
+  m_clock.scheduleAfter(m_options.retryInterval, [this, license] { activate(license); });
+}
+
+void LicenseSimulator::check(std::size_t license)
+{
+  auto &lifecycle = m_licenses.at(license).lifecycle;
+  if (lifecycle.state() == State::kExpired) {
+    return;
+  }
+
+  auto disabled = false;
+  switch (request(license)) {
+    using enum Response;
+
+  case kSuccess:
+    lifecycle.checkSucceeded();
+    break;
+
+  case kDisabled:
+    lifecycle.disable();
+    disabled = true;
+    break;
+
+  case kFailed:
+    disabled = lifecycle.checkFailed();
+    break;
+  }
+
+  record(license);
+
+  if (disabled) {
+    // Like the user clicking start again once they've sorted the license out.
+    m_clock.scheduleAfter(m_options.retryInterval, [this, license] { activate(license); });
+  } else {
+    m_clock.scheduleAfter(m_options.checkInterval, [this, license] { check(license); });
+  }
+}
+
+LicenseSimulator::Response LicenseSimulator::request(std::size_t license)
+{
+  m_requests++;
+  return m_server(license, m_clock.now());
+}
+
+void LicenseSimulator::record(std::size_t license)
+{
+  auto &simulated = m_licenses.at(license);
+  const auto state = simulated.lifecycle.state();
+  if (state != simulated.last) {
+    m_transitions.push_back({license, m_clock.now(), simulated.last, state});
+    simulated.last = state;
+  }
+}
+
+} // namespace synergy::license
@@ -0,0 +1,125 @@
+/*
+ * Synergy -- mouse and keyboard sharing utility
+ * Copyright (C) 2026 Symless Ltd.
+ *
+ * This package is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * found in the file LICENSE that should have accompanied this file.
+ *
+ * This package is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include "VirtualClock.h"
+#include "synergy/license/LicenseLifecycle.h"
+
+#include <chrono>
+#include <deque>
+#include <functional>
+#include <utility>
+#include <vector>
+
+namespace synergy::license {
+
+/**
+ * @brief Plays the lifecycle of many licenses over simulated time.
+ *
+ * Each license is activated as soon as it's added, and retried until activation
+ * works. Business licenses are then checked every check interval, like the app does,
+ * and the server decides how each request goes. Warn and expire times are sampled
+ * too, so every change of state is recorded as a transition.
+ */
+class LicenseSimulator
+{
+  using time_point = VirtualClock::time_point;
+  using seconds = std::chrono::seconds;
+
+public:
+  using State = LicenseLifecycle::State;
+
+  enum class Response
+  {
+    kSuccess,
+    kFailed,
+    kDisabled
+  };
+
+  /// Answers an activation or check for the license, at the simulated time.
+  using Server = std::function<Response(std::size_t license, time_point now)>;
+
+  struct Options
+  {
+    seconds checkInterval = std::chrono::days{1};
+    seconds gracePeriod = std::chrono::days{14};
+    seconds retryInterval = std::chrono::hours{1};
+  };
+
+  struct Transition
+  {
+    std::size_t license;
+    time_point at;
+    State from;
+    State to;
+  };
+
+  LicenseSimulator(VirtualClock &clock, Options options, Server server);
+
+  std::size_t add(const SerialKey &serialKey);
+
+  std::size_t count() const
+  {
+    return m_licenses.size();
+  }
+  const LicenseLifecycle &lifecycle(std::size_t license) const
+  {
+    return m_licenses.at(license).lifecycle;
+  }
+  State state(std::size_t license) const
+  {
+    return lifecycle(license).state();
+  }
+  const std::vector<Transition> &transitions() const
+  {
+    return m_transitions;
+  }
+  std::vector<Transition> transitionsOf(std::size_t license) const;
+  std::size_t requests() const
+  {
+    return m_requests;
+  }
+
+private:
+  struct Simulated
+  {
+    template <typename... Args> explicit Simulated(Args &&...args) : lifecycle(std::forward<Args>(args)...)
+    {
+    }
+
+    LicenseLifecycle lifecycle;
+    State last = State::kUnactivated;
+  };
+
+  void activate(std::size_t license);
+  void check(std::size_t license);
+  Response request(std::size_t license);
+  void record(std::size_t license);
+
+  VirtualClock &m_clock;
+  Options m_options;
+  Server m_server;
+
+  // Lifecycles hold a license, which can only be copied by its friends, so they're
+  // built in place and never relocated.
+  std::deque<Simulated> m_licenses;
+  std::vector<Transition> m_transitions;
+  std::size_t m_requests = 0;
+};
+
+} // namespace synergy::license
@@ -0,0 +1,156 @@
+/*
+ * Synergy -- mouse and keyboard sharing utility
+ * Copyright (C) 2026 Symless Ltd.
+ *
+ * This package is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * found in the file LICENSE that should have accompanied this file.
+ *
+ * This package is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "MockLicenseApi.h"
+
+#include "synergy/gui/license/license_wire.h"
+
+#include <QCborMap>
+#include <QFile>
+#include <QJsonDocument>
+#include <QPointer>
+#include <QRandomGenerator>
+#include <QTcpSocket>
+#include <QTimer>
+#include <QtCore>
+
+namespace synergy::gui::license {
+
+const auto kEndpoints = QStringList{"activate", "check", "heartbeat"};
+
+MockLicenseApi::Behavior MockLicenseApi::Behavior::fromJson(const QJsonObject &json)
+{
+  Behavior behavior;
+  behavior.status = json["status"].toString(behavior.status);
+  behavior.message = json["message"].toString();
+  behavior.latencyMs = json["latencyMs"].toInt();
+  behavior.jitterMs = json["jitterMs"].toInt();
+  behavior.dropRate = json["dropRate"].toDouble();
+  behavior.errorRate = json["errorRate"].toDouble();
+  return behavior;
+}
+
+MockLicenseApi::MockLicenseApi(QObject *parent)
+    : QObject(parent),
+      m_http([this](const LocalHttpServer::Request &request, QTcpSocket *socket) { handleRequest(request, socket); })
+{
+  for (const auto &endpoint : kEndpoints) {
+    m_behaviors.insert(endpoint, {});
+  }
+}
+
+bool MockLicenseApi::listen(quint16 port)
+{
+  if (!m_http.listen(QHostAddress::LocalHost, port)) {
+    qWarning().noquote() << "mock license api failed to listen:" << m_http.errorString();
+    return false;
+  }
+
+  qInfo("mock license api listening on port %d", m_http.port());
+  return true;
+}
+
+quint16 MockLicenseApi::port() const
+{
+  return m_http.port();
+}
+
+QString MockLicenseApi::url(const QString &endpoint) const
+{
+  return QString("http://127.0.0.1:%1/synergy/api/product/%2").arg(port()).arg(endpoint);
+}
+
+void MockLicenseApi::setBehavior(const QString &endpoint, const Behavior &behavior)
+{
+  m_behaviors.insert(endpoint, behavior);
+}
+
+bool MockLicenseApi::loadScript(const QString &path)
+{
+  QFile file(path);
+  if (!file.open(QIODevice::ReadOnly)) {
+    qWarning().noquote() << "unable to open mock license api script:" << path;
+    return false;
+  }
+
+  QJsonParseError error;
+  const auto script = QJsonDocument::fromJson(file.readAll(), &error).object();
+  if (error.error != QJsonParseError::NoError) {
+    qWarning().noquote() << "invalid mock license api script:" << error.errorString();
+    return false;
+  }
+
+  for (const auto &endpoint : kEndpoints) {
+    if (script.contains(endpoint)) {
+      setBehavior(endpoint, Behavior::fromJson(script[endpoint].toObject()));
+    }
+  }
+  return true;
+}
+
+MockLicenseApi::Stats MockLicenseApi::stats() const
+{
+  return {m_requests.load(), m_dropped.load(), m_errors.load(), m_answered.load()};
+}
+
+void MockLicenseApi::handleRequest(const LocalHttpServer::Request &request, QTcpSocket *socket)
+{
+  m_requests++;
+
+  const auto endpoint = QString::fromLatin1(request.path.mid(request.path.lastIndexOf('/') + 1));
+  if (request.method != "POST" || !m_behaviors.contains(endpoint)) {
+    LocalHttpServer::respond(socket, 404, {}, {});
+    return;
+  }
+
+  const auto behavior = m_behaviors.value(endpoint);
+  auto random = QRandomGenerator::global();
+  if (random->generateDouble() < behavior.dropRate) {
+    // Like a load balancer giving up on the connection.
+    m_dropped++;
+    socket->abort();
+    return;
+  }
+
+  const auto isError = random->generateDouble() < behavior.errorRate;
+  const auto jitter = behavior.jitterMs > 0 ? random->bounded(behavior.jitterMs) : 0;
+  const auto format = responseWireFormat(QString::fromLatin1(request.contentType));
+
+  QCborMap body;
+  body[QStringLiteral("status")] = behavior.status;
+  if (!behavior.message.isEmpty()) {
+    body[QStringLiteral("message")] = behavior.message;
+  }
+
+  QPointer<QTcpSocket> guard(socket);
+  QTimer::singleShot(behavior.latencyMs + jitter, this, [this, guard, isError, format, body] {
+    if (guard.isNull()) {
+      return;
+    }
+
+    if (isError) {
+      m_errors++;
+      LocalHttpServer::respond(guard, 503, {}, {});
+      return;
+    }
+
+    m_answered++;
+    LocalHttpServer::respond(guard, 200, contentType(format), encodeMessage(body, format));
+  });
+}
+
+} // namespace synergy::gui::license
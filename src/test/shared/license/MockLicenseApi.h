@@ -0,0 +1,89 @@
+/*
+ * Synergy -- mouse and keyboard sharing utility
+ * Copyright (C) 2026 Symless Ltd.
+ *
+ * This package is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * found in the file LICENSE that should have accompanied this file.
+ *
+ * This package is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include "synergy/gui/license/LocalHttpServer.h"
+
+#include <QHash>
+#include <QJsonObject>
+#include <QObject>
+#include <QString>
+
+#include <atomic>
+
+namespace synergy::gui::license {
+
+/**
+ * @brief Stands in for the license API on localhost, for tests and load testing.
+ *
+ * Each endpoint (activate, check, heartbeat) answers according to its behavior, which
+ * can be scripted as JSON, e.g.:
+ *
+ *    {"check": {"status": "failed", "message": "no", "latencyMs": 200, "dropRate": 0.1}}
+ *
+ * Status is one of success, failed or disabled. A request may also be delayed (latency
+ * plus random jitter), dropped without a response, or answered with a server error.
+ */
+class MockLicenseApi : public QObject
+{
+  Q_OBJECT
+
+public:
+  struct Behavior
+  {
+    QString status = "success";
+    QString message;
+    int latencyMs = 0;
+    int jitterMs = 0;
+    double dropRate = 0;
+    double errorRate = 0;
+
+    static Behavior fromJson(const QJsonObject &json);
+  };
+
+  struct Stats
+  {
+    quint64 requests = 0;
+    quint64 dropped = 0;
+    quint64 errors = 0;
+    quint64 answered = 0;
+  };
+
+  explicit MockLicenseApi(QObject *parent = nullptr);
+
+  bool listen(quint16 port = 0);
+  quint16 port() const;
+  QString url(const QString &endpoint) const;
+
+  void setBehavior(const QString &endpoint, const Behavior &behavior);
+  bool loadScript(const QString &path);
+
+  Stats stats() const;
+
+private:
+  void handleRequest(const LocalHttpServer::Request &request, QTcpSocket *socket);
+
+  LocalHttpServer m_http;
+  QHash<QString, Behavior> m_behaviors;
+  std::atomic_uint64_t m_requests = 0;
+  std::atomic_uint64_t m_dropped = 0;
+  std::atomic_uint64_t m_errors = 0;
+  std::atomic_uint64_t m_answered = 0;
+};
+
+} // namespace synergy::gui::license
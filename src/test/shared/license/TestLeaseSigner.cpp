@@ -0,0 +1,77 @@
+/*
+ * Synergy -- mouse and keyboard sharing utility
+ * Copyright (C) 2026 Symless Ltd.
+ *
+ * This package is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * found in the file LICENSE that should have accompanied this file.
+ *
+ * This package is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "TestLeaseSigner.h"
+
+#include "synergy/gui/license/LicenseLease.h"
+
+#include <QJsonDocument>
+
+namespace synergy::gui::license {
+
+const auto kBase64Options = QByteArray::Base64UrlEncoding | QByteArray::OmitTrailingEquals;
+const auto kKeySize = 32;
+const auto kSignatureSize = 64;
+
+TestLeaseSigner::TestLeaseSigner()
+{
+  const auto context = std::unique_ptr<EVP_PKEY_CTX, decltype(&EVP_PKEY_CTX_free)>(
+      EVP_PKEY_CTX_new_id(EVP_PKEY_ED25519, nullptr), &EVP_PKEY_CTX_free
+  );
+  EVP_PKEY *key = nullptr;
+  if (context && EVP_PKEY_keygen_init(context.get()) == 1) {
+    EVP_PKEY_keygen(context.get(), &key);
+  }
+  m_key.reset(key);
+}
+
+QByteArray TestLeaseSigner::publicKey() const
+{
+  QByteArray raw(kKeySize, '\0');
+  auto size = static_cast<size_t>(raw.size());
+  EVP_PKEY_get_raw_public_key(m_key.get(), reinterpret_cast<unsigned char *>(raw.data()), &size);
+  return raw;
+}
+
+QString TestLeaseSigner::sign(const QJsonObject &payload) const
+{
+  const auto encoded = QJsonDocument(payload).toJson(QJsonDocument::Compact).toBase64(kBase64Options);
+
+  QByteArray signature(kSignatureSize, '\0');
+  auto size = static_cast<size_t>(signature.size());
+  const auto context = std::unique_ptr<EVP_MD_CTX, decltype(&EVP_MD_CTX_free)>(EVP_MD_CTX_new(), &EVP_MD_CTX_free);
+  EVP_DigestSignInit(context.get(), nullptr, nullptr, nullptr, m_key.get());
+  EVP_DigestSign(
+      context.get(), reinterpret_cast<unsigned char *>(signature.data()), &size,
+      reinterpret_cast<const unsigned char *>(encoded.constData()), encoded.size()
+  );
+  return QString::fromLatin1(encoded + "." + signature.toBase64(kBase64Options));
+}
+
+QString TestLeaseSigner::lease(
+    const QString &serialKey, const QString &machineSignature, qint64 issuedAtSecs, qint64 notAfterSecs
+) const
+{
+  return sign({
+      {"serialHash", LicenseLease::serialHash(serialKey)},
+      {"machineSignature", machineSignature},
+      {"issuedAt", issuedAtSecs},
+      {"notAfter", notAfterSecs},
+  });
+}
+
+} // namespace synergy::gui::license
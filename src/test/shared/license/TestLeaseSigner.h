@@ -0,0 +1,49 @@
+/*
+ * Synergy -- mouse and keyboard sharing utility
+ * Copyright (C) 2026 Symless Ltd.
+ *
+ * This package is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * found in the file LICENSE that should have accompanied this file.
+ *
+ * This package is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <QByteArray>
+#include <QJsonObject>
+#include <QString>
+
+#include <memory>
+#include <openssl/evp.h>
+
+namespace synergy::gui::license {
+
+/**
+ * @brief Signs leases with a throwaway Ed25519 key, standing in for the license server.
+ *
+ * Set `SYNERGY_TEST_LEASE_PUBLIC_KEY` to `publicKey().toBase64()` so that code using
+ * `leasePublicKey` accepts the leases; that only works in debug builds.
+ */
+class TestLeaseSigner
+{
+public:
+  TestLeaseSigner();
+
+  QByteArray publicKey() const;
+  QString sign(const QJsonObject &payload) const;
+  QString lease(const QString &serialKey, const QString &machineSignature, qint64 issuedAtSecs, qint64 notAfterSecs)
+      const;
+
+private:
+  std::unique_ptr<EVP_PKEY, decltype(&EVP_PKEY_free)> m_key{nullptr, &EVP_PKEY_free};
+};
+
+} // namespace synergy::gui::license
@@ -0,0 +1,69 @@
+/*
+ * Synergy -- mouse and keyboard sharing utility
+ * Copyright (C) 2026 Symless Ltd.
+ *
+ * This package is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * found in the file LICENSE that should have accompanied this file.
+ *
+ * This package is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "VirtualClock.h"
+
+#include <algorithm>
+
+namespace synergy::license {
+
+VirtualClock::TimerId VirtualClock::schedule(time_point due, Callback callback)
+{
+  const auto id = m_nextId++;
+  m_heap.push_back({std::max(due, m_now), id, std::move(callback)});
+  std::push_heap(m_heap.begin(), m_heap.end(), isLater);
+  m_live.insert(id);
+  return id;
+}
+
+VirtualClock::TimerId VirtualClock::scheduleAfter(duration delay, Callback callback)
+{
+  return schedule(m_now + delay, std::move(callback));
+}
+
+bool VirtualClock::cancel(TimerId id)
+{
+  return m_live.erase(id) > 0;
+}
+
+std::size_t VirtualClock::runUntil(time_point end)
+{
+  std::size_t fired = 0;
+  while (!m_heap.empty() && m_heap.front().due <= end) {
+    std::pop_heap(m_heap.begin(), m_heap.end(), isLater);
+    auto timer = std::move(m_heap.back());
+    m_heap.pop_back();
+
+    if (m_live.erase(timer.id) == 0) {
+      continue;
+    }
+
+    m_now = timer.due;
+    timer.callback();
+    fired++;
+  }
+
+  m_now = std::max(m_now, end);
+  return fired;
+}
+
+std::size_t VirtualClock::runFor(duration duration)
+{
+  return runUntil(m_now + duration);
+}
+
+} // namespace synergy::license
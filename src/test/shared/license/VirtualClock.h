@@ -0,0 +1,96 @@
+/*
+ * Synergy -- mouse and keyboard sharing utility
+ * Copyright (C) 2026 Symless Ltd.
+ *
+ * This package is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * found in the file LICENSE that should have accompanied this file.
+ *
+ * This package is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <unordered_set>
+#include <vector>
+
+namespace synergy::license {
+
+/**
+ * @brief A clock and timer queue that only moves when told to, for simulations.
+ *
+ * Timers fire in due order (then in the order they were scheduled), and the clock
+ * jumps straight to each one, so months pass in however long the callbacks take.
+ * Scheduling and firing are O(log n), so thousands of timers are cheap.
+ */
+class VirtualClock
+{
+public:
+  using time_point = std::chrono::system_clock::time_point;
+  using duration = std::chrono::system_clock::duration;
+  using Callback = std::function<void()>;
+  using TimerId = std::uint64_t;
+
+  explicit VirtualClock(time_point start) : m_now(start)
+  {
+  }
+
+  time_point now() const
+  {
+    return m_now;
+  }
+
+  /**
+   * @brief Runs the callback at the due time, or straight away on the next run if
+   *    that has already passed.
+   */
+  TimerId schedule(time_point due, Callback callback);
+  TimerId scheduleAfter(duration delay, Callback callback);
+  bool cancel(TimerId id);
+
+  /**
+   * @brief Fires every timer due up to the end (including any they schedule), then
+   *    moves the clock to the end.
+   *
+   * @return How many timers fired.
+   */
+  std::size_t runUntil(time_point end);
+  std::size_t runFor(duration duration);
+
+  std::size_t pending() const
+  {
+    return m_live.size();
+  }
+
+private:
+  struct Timer
+  {
+    time_point due;
+    TimerId id;
+    Callback callback;
+  };
+
+  // Makes the heap a min-heap, so the earliest timer is at the front.
+  static bool isLater(const Timer &lhs, const Timer &rhs)
+  {
+    return lhs.due != rhs.due ? lhs.due > rhs.due : lhs.id > rhs.id;
+  }
+
+  time_point m_now;
+  TimerId m_nextId = 1;
+  std::vector<Timer> m_heap;
+
+  // Canceled timers stay in the heap until they reach the front.
+  std::unordered_set<TimerId> m_live;
+};
+
+} // namespace synergy::license
@@ -0,0 +1,51 @@
+/*
+ * Synergy -- mouse and keyboard sharing utility
+ * Copyright (C) 2026 Symless Ltd.
+ *
+ * This package is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * found in the file LICENSE that should have accompanied this file.
+ *
+ * This package is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "synergy/gui/StallWatchdog.h"
+
+#include <gtest/gtest.h>
+
+#include <thread>
+
+using namespace std::chrono;
+using namespace synergy::gui;
+
+// There's no event loop here, so the heartbeat never moves, which is a stall.
+TEST(StallWatchdogTests, stop_blockedInScope_stallBlamedOnScope)
+{
+  StallWatchdog watchdog(milliseconds{5}, milliseconds{20});
+  watchdog.start();
+
+  {
+    StallWatchdog::Scope scope("test::blocking");
+    std::this_thread::sleep_for(milliseconds{100});
+    watchdog.stop();
+  }
+
+  const auto summary = watchdog.summary();
+  ASSERT_EQ(1, summary.count);
+  ASSERT_EQ(1, summary.worst.size());
+  EXPECT_STREQ("test::blocking", summary.worst.front().scope);
+  EXPECT_GE(summary.worst.front().duration, milliseconds{20});
+}
+
+TEST(StallWatchdogTests, summary_notStarted_noStalls)
+{
+  StallWatchdog watchdog(milliseconds{5}, milliseconds{20});
+
+  EXPECT_EQ(0, watchdog.summary().count);
+}
@@ -0,0 +1,59 @@
+/*
+ * Synergy -- mouse and keyboard sharing utility
+ * Copyright (C) 2026 Symless Ltd.
+ *
+ * This package is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * found in the file LICENSE that should have accompanied this file.
+ *
+ * This package is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "synergy/gui/license/LicenseApiClient.h"
+
+#include <QRandomGenerator>
+
+#include <gtest/gtest.h>
+
+using namespace synergy::gui::license;
+using namespace std::chrono;
+
+TEST(LicenseApiClientTests, retryDelay_firstFailure_atMostFirstDelay)
+{
+  QRandomGenerator random(1);
+
+  for (int i = 0; i < 100; i++) {
+    const auto delay = LicenseApiClient::retryDelay(1, milliseconds{1000}, milliseconds{60000}, random);
+    EXPECT_GE(delay.count(), 0);
+    EXPECT_LE(delay.count(), 1000);
+  }
+}
+
+TEST(LicenseApiClientTests, retryDelay_manyFailures_cappedAtMax)
+{
+  QRandomGenerator random(1);
+
+  for (int i = 0; i < 100; i++) {
+    EXPECT_LE(LicenseApiClient::retryDelay(1000, milliseconds{1000}, milliseconds{60000}, random).count(), 60000);
+  }
+}
+
+TEST(LicenseApiClientTests, retryDelay_moreFailures_longerOnAverage)
+{
+  QRandomGenerator random(1);
+  auto total = [&random](int failures) {
+    qint64 sum = 0;
+    for (int i = 0; i < 1000; i++) {
+      sum += LicenseApiClient::retryDelay(failures, milliseconds{1000}, milliseconds{60000}, random).count();
+    }
+    return sum;
+  };
+
+  EXPECT_LT(total(1), total(4));
+}
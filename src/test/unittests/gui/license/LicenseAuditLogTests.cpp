@@ -0,0 +1,174 @@
+/*
+ * Synergy -- mouse and keyboard sharing utility
+ * Copyright (C) 2026 Symless Ltd.
+ *
+ * This package is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * found in the file LICENSE that should have accompanied this file.
+ *
+ * This package is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "synergy/gui/license/LicenseAuditLog.h"
+
+#include <QFile>
+#include <QLockFile>
+#include <QTemporaryDir>
+
+#include <gtest/gtest.h>
+
+using namespace synergy::gui::license;
+using Type = LicenseAuditLog::Type;
+
+class LicenseAuditLogTests : public testing::Test
+{
+protected:
+  QString path() const
+  {
+    return m_dir.filePath("license-audit.bin");
+  }
+
+  QTemporaryDir m_dir;
+};
+
+TEST_F(LicenseAuditLogTests, readFile_afterAppend_sameEvents)
+{
+  {
+    LicenseAuditLog log(path());
+    ASSERT_TRUE(log.open());
+    log.append({.type = Type::kGraceStarted, .value = 1700000000});
+    log.append(LicenseAuditLog::resultEvent(
+        Type::kCheckResult, LicenseApiClient::Result::Status::kNetworkError, std::chrono::milliseconds{1500}
+    ));
+  }
+
+  const auto records = LicenseAuditLog::readFile(path());
+
+  ASSERT_TRUE(records.has_value());
+  ASSERT_EQ(2, records->size());
+  EXPECT_EQ(1, records->at(0).sequence);
+  EXPECT_EQ(static_cast<quint16>(Type::kGraceStarted), records->at(0).type);
+  EXPECT_EQ(1700000000, records->at(0).value);
+  EXPECT_EQ(static_cast<quint16>(Type::kCheckResult), records->at(1).type);
+  EXPECT_EQ(1500, records->at(1).latencyMs);
+}
+
+TEST_F(LicenseAuditLogTests, readFile_reopened_appendsAfterPrevious)
+{
+  for (auto i = 0; i < 2; i++) {
+    LicenseAuditLog log(path());
+    ASSERT_TRUE(log.open());
+    log.append({.type = Type::kFeatureClamped, .detail = "tls"});
+  }
+
+  const auto records = LicenseAuditLog::readFile(path());
+
+  ASSERT_TRUE(records.has_value());
+  ASSERT_EQ(2, records->size());
+  EXPECT_EQ(2, records->at(1).sequence);
+}
+
+TEST_F(LicenseAuditLogTests, readFile_wrappedAround_newestEventsInOrder)
+{
+  {
+    LicenseAuditLog log(path(), 4);
+    ASSERT_TRUE(log.open());
+    for (auto i = 1; i <= 10; i++) {
+      log.append({.type = Type::kGraceStarted, .value = i});
+    }
+  }
+
+  const auto records = LicenseAuditLog::readFile(path());
+
+  ASSERT_TRUE(records.has_value());
+  ASSERT_EQ(4, records->size());
+  for (auto i = 0; i < 4; i++) {
+    EXPECT_EQ(7 + i, records->at(i).value);
+  }
+}
+
+TEST_F(LicenseAuditLogTests, readFile_whileOpen_sameEvents)
+{
+  LicenseAuditLog log(path());
+  ASSERT_TRUE(log.open());
+  log.append({.type = Type::kGraceStarted, .value = 1700000000});
+  log.append({.type = Type::kGraceCleared, .detail = "check"});
+
+  const auto records = LicenseAuditLog::readFile(path());
+
+  ASSERT_TRUE(records.has_value());
+  ASSERT_EQ(2, records->size());
+  EXPECT_EQ(1, records->at(0).sequence);
+  EXPECT_EQ(2, records->at(1).sequence);
+  EXPECT_EQ(static_cast<quint16>(Type::kGraceCleared), records->at(1).type);
+}
+
+TEST_F(LicenseAuditLogTests, open_lockedByOtherProcess_notCreated)
+{
+  QLockFile lock(path() + ".lock");
+  ASSERT_TRUE(lock.tryLock(0));
+
+  LicenseAuditLog log(path());
+
+  EXPECT_FALSE(log.open());
+  EXPECT_FALSE(QFile::exists(path()));
+}
+
+TEST_F(LicenseAuditLogTests, open_done_lockReleased)
+{
+  LicenseAuditLog log(path());
+  ASSERT_TRUE(log.open());
+
+  QLockFile lock(path() + ".lock");
+  EXPECT_TRUE(lock.tryLock(0));
+}
+
+TEST_F(LicenseAuditLogTests, readFile_notAuditLog_nothing)
+{
+  QFile raw(path());
+  ASSERT_TRUE(raw.open(QIODevice::WriteOnly));
+  raw.write("[General]\nactivated=true\n");
+  raw.close();
+
+  EXPECT_FALSE(LicenseAuditLog::readFile(path()).has_value());
+}
+
+TEST_F(LicenseAuditLogTests, toText_longDetail_truncated)
+{
+  {
+    LicenseAuditLog log(path());
+    ASSERT_TRUE(log.open());
+    log.append({.type = Type::kRemoteDisable, .detail = QByteArray(100, 'a')});
+  }
+
+  const auto records = LicenseAuditLog::readFile(path());
+  ASSERT_TRUE(records.has_value());
+  ASSERT_EQ(1, records->size());
+
+  const auto text = LicenseAuditLog::toText(records->at(0));
+  EXPECT_TRUE(text.contains("remote_disable"));
+  EXPECT_TRUE(text.contains(QString(" detail=\"%1\"").arg(QString(31, 'a'))));
+}
+
+TEST_F(LicenseAuditLogTests, append_multiByteCharAtLimit_notSplit)
+{
+  {
+    LicenseAuditLog log(path());
+    ASSERT_TRUE(log.open());
+
+    // The two bytes of "é" straddle the 31 bytes that fit.
+    log.append({.type = Type::kRemoteDisable, .detail = QByteArray(30, 'a') + "\xc3\xa9"});
+  }
+
+  const auto records = LicenseAuditLog::readFile(path());
+  ASSERT_TRUE(records.has_value());
+  ASSERT_EQ(1, records->size());
+
+  EXPECT_EQ(QByteArray(30, 'a'), QByteArray(records->at(0).detail));
+}
@@ -0,0 +1,148 @@
+/*
+ * Synergy -- mouse and keyboard sharing utility
+ * Copyright (C) 2026 Symless Ltd.
+ *
+ * This package is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * found in the file LICENSE that should have accompanied this file.
+ *
+ * This package is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "synergy/gui/license/LicenseCheckScheduler.h"
+
+#include "synergy/gui/constants.h"
+
+#include <algorithm>
+#include <climits>
+#include <gtest/gtest.h>
+
+using namespace std::chrono;
+using namespace synergy::gui;
+using namespace synergy::gui::license;
+
+namespace {
+
+const auto kPeriod = seconds{days{1}};
+const qint64 kNowSecs = 1700000000;
+const auto kSeeds = 200;
+
+} // namespace
+
+TEST(LicenseCheckSchedulerTests, stableOffset_sameSignature_sameOffset)
+{
+  const auto signature = QStringLiteral("9f86d081884c7d659a2feaa0c55ad015");
+
+  EXPECT_EQ(
+      LicenseCheckScheduler::stableOffset(signature, kPeriod), LicenseCheckScheduler::stableOffset(signature, kPeriod)
+  );
+}
+
+TEST(LicenseCheckSchedulerTests, stableOffset_anySignature_withinPeriod)
+{
+  for (const auto &signature : {"0000000000000000", "ffffffffffffffff", "9f86d081884c7d65", "60303ae22b998861"}) {
+    const auto offset = LicenseCheckScheduler::stableOffset(signature, kPeriod);
+    EXPECT_GE(offset.count(), 0) << signature;
+    EXPECT_LT(offset, kPeriod) << signature;
+  }
+}
+
+TEST(LicenseCheckSchedulerTests, stableOffset_differentSignatures_differentOffsets)
+{
+  EXPECT_NE(
+      LicenseCheckScheduler::stableOffset("9f86d081884c7d65", kPeriod),
+      LicenseCheckScheduler::stableOffset("60303ae22b998861", kPeriod)
+  );
+}
+
+TEST(LicenseCheckSchedulerTests, stableOffset_notHex_zero)
+{
+  EXPECT_EQ(seconds{0}, LicenseCheckScheduler::stableOffset("not a signature", kPeriod));
+  EXPECT_EQ(seconds{0}, LicenseCheckScheduler::stableOffset("", kPeriod));
+}
+
+TEST(LicenseCheckSchedulerTests, nextSlotSecs_anyTime_nextSlotWithinPeriod)
+{
+  const auto offset = seconds{3600};
+  for (const auto now : {kNowSecs, kNowSecs + 1, kNowSecs + 3599, kNowSecs + 86399}) {
+    const auto next = LicenseCheckScheduler::nextSlotSecs(now, offset, kPeriod);
+    EXPECT_GT(next, now);
+    EXPECT_LE(next, now + kPeriod.count());
+    EXPECT_EQ(0, (next - offset.count()) % kPeriod.count());
+  }
+}
+
+TEST(LicenseCheckSchedulerTests, nextSlotSecs_onSlot_followingSlot)
+{
+  const auto offset = seconds{kNowSecs % kPeriod.count()};
+
+  EXPECT_EQ(kNowSecs + kPeriod.count(), LicenseCheckScheduler::nextSlotSecs(kNowSecs, offset, kPeriod));
+}
+
+TEST(LicenseCheckSchedulerTests, nextSlotSecs_offsetAfterNow_sameDay)
+{
+  // Phase is negative before the offset, which must still give a slot later today.
+  const auto offset = seconds{kPeriod.count() - 10};
+  const auto dayStart = kNowSecs - (kNowSecs % kPeriod.count());
+
+  EXPECT_EQ(dayStart + offset.count(), LicenseCheckScheduler::nextSlotSecs(dayStart, offset, kPeriod));
+}
+
+TEST(LicenseCheckSchedulerTests, firstDueSecs_recentCheck_nextSlot)
+{
+  QRandomGenerator random(1);
+  const auto offset = seconds{3600};
+
+  const auto due = LicenseCheckScheduler::firstDueSecs(kNowSecs, kNowSecs - 60, offset, kPeriod, random);
+
+  EXPECT_EQ(LicenseCheckScheduler::nextSlotSecs(kNowSecs, offset, kPeriod), due);
+}
+
+TEST(LicenseCheckSchedulerTests, firstDueSecs_overdue_spreadOverStartup)
+{
+  const auto spread = duration_cast<seconds>(kLicenseCheckStartupSpread).count();
+  qint64 earliest = LLONG_MAX;
+  qint64 latest = 0;
+  for (auto seed = 0; seed < kSeeds; seed++) {
+    QRandomGenerator random(seed);
+    const auto due = LicenseCheckScheduler::firstDueSecs(kNowSecs, 0, seconds{3600}, kPeriod, random);
+    ASSERT_GE(due, kNowSecs);
+    ASSERT_LT(due, kNowSecs + spread);
+    earliest = std::min(earliest, due);
+    latest = std::max(latest, due);
+  }
+
+  // Not all at once, or it wouldn't be spread at all.
+  EXPECT_GT(latest - earliest, spread / 2);
+}
+
+TEST(LicenseCheckSchedulerTests, jitter_anySeed_underTwentiethOfPeriod)
+{
+  const auto maxJitter = duration_cast<milliseconds>(kPeriod) / 20;
+  for (auto seed = 0; seed < kSeeds; seed++) {
+    QRandomGenerator random(seed);
+    const auto jitter = LicenseCheckScheduler::jitter(kPeriod, random);
+    ASSERT_GE(jitter.count(), 0);
+    ASSERT_LT(jitter, maxJitter);
+  }
+}
+
+TEST(LicenseCheckSchedulerTests, jitter_tinyPeriod_zero)
+{
+  QRandomGenerator random(1);
+
+  EXPECT_EQ(milliseconds{0}, LicenseCheckScheduler::jitter(seconds{0}, random));
+}
+
+TEST(LicenseCheckSchedulerTests, jitter_hugePeriod_fitsTimer)
+{
+  QRandomGenerator random(1);
+
+  EXPECT_LE(LicenseCheckScheduler::jitter(seconds{days{365 * 10}}, random).count(), INT_MAX);
+}
@@ -0,0 +1,203 @@
+/*
+ * Synergy -- mouse and keyboard sharing utility
+ * Copyright (C) 2026 Symless Ltd.
+ *
+ * This package is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * found in the file LICENSE that should have accompanied this file.
+ *
+ * This package is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "shared/license/TestLeaseSigner.h"
+#include "synergy/gui/license/LicenseCoordinator.h"
+#include "synergy/gui/license/LicenseLease.h"
+
+#include <QDateTime>
+#include <QDir>
+#include <QFile>
+#include <QJsonDocument>
+#include <QTemporaryDir>
+
+#include <gtest/gtest.h>
+
+#ifndef Q_OS_WIN
+#include <sys/stat.h>
+#endif
+
+using namespace synergy::gui::license;
+
+namespace {
+
+using Kind = LicenseCoordinator::Kind;
+using Result = LicenseApiClient::Result;
+
+const auto kSerialKey = QStringLiteral("7B76313B70726F3B7D");
+const auto kMachineSignature = QStringLiteral("9f86d081884c7d659a2feaa0c55ad015");
+const auto kLeaseLifetimeSecs = 3600;
+
+} // namespace
+
+class LicenseCoordinatorTests : public testing::Test
+{
+protected:
+  void SetUp() override
+  {
+#ifdef NDEBUG
+    GTEST_SKIP() << "lease public key can only be overridden by env var in debug builds";
+#endif // NDEBUG
+
+    qputenv("SYNERGY_TEST_LICENSE_STATE_DIR", stateDir().toUtf8());
+    qputenv("SYNERGY_TEST_LEASE_PUBLIC_KEY", m_signer.publicKey().toBase64());
+  }
+
+  void TearDown() override
+  {
+    qunsetenv("SYNERGY_TEST_LICENSE_STATE_DIR");
+    qunsetenv("SYNERGY_TEST_LEASE_PUBLIC_KEY");
+  }
+
+  QString stateDir() const
+  {
+    return m_dir.filePath("license");
+  }
+
+  // As another process (or another user) would have left it.
+  void writeSharedEntry(const QJsonObject &entry, const QString &user = "other") const
+  {
+    const QJsonObject state{{LicenseLease::serialHash(kSerialKey), QJsonObject{{"check", entry}}}};
+    QFile file(QDir(stateDir()).filePath(QString("machine-%1-%2.json").arg(kMachineSignature.left(16), user)));
+    ASSERT_TRUE(file.open(QIODevice::WriteOnly));
+    file.write(QJsonDocument(state).toJson());
+  }
+
+  QString validLease(const QString &machineSignature = kMachineSignature) const
+  {
+    const auto now = QDateTime::currentSecsSinceEpoch();
+    return m_signer.lease(kSerialKey, machineSignature, now, now + kLeaseLifetimeSecs);
+  }
+
+  QFuture<Result> run(LicenseCoordinator &coordinator)
+  {
+    return coordinator.run(Kind::kCheck, kMachineSignature, kSerialKey, [this] {
+      m_requests++;
+      QPromise<Result> promise;
+      promise.start();
+      promise.addResult(Result{});
+      promise.finish();
+      return promise.future();
+    });
+  }
+
+  QTemporaryDir m_dir;
+  TestLeaseSigner m_signer;
+  int m_requests = 0;
+};
+
+TEST_F(LicenseCoordinatorTests, run_sharedSignedLease_reusesResult)
+{
+  LicenseCoordinator coordinator;
+  const auto lease = validLease();
+  writeSharedEntry({{"lease", lease}, {"time", QDateTime::currentSecsSinceEpoch()}});
+
+  const auto future = run(coordinator);
+
+  EXPECT_EQ(0, m_requests);
+  ASSERT_TRUE(future.isFinished());
+  EXPECT_EQ(Result::Status::kSuccess, future.result().status);
+  EXPECT_EQ(lease, future.result().lease);
+}
+
+TEST_F(LicenseCoordinatorTests, run_sharedStatusWithoutLease_sendsRequest)
+{
+  LicenseCoordinator coordinator;
+  writeSharedEntry(
+      {{"status", static_cast<int>(Result::Status::kSuccess)}, {"time", QDateTime::currentSecsSinceEpoch()}}
+  );
+
+  run(coordinator);
+
+  EXPECT_EQ(1, m_requests);
+}
+
+TEST_F(LicenseCoordinatorTests, run_sharedDisabled_sendsRequest)
+{
+  LicenseCoordinator coordinator;
+  writeSharedEntry(
+      {{"status", static_cast<int>(Result::Status::kDisabled)}, {"time", QDateTime::currentSecsSinceEpoch()}}
+  );
+
+  run(coordinator);
+
+  EXPECT_EQ(1, m_requests);
+}
+
+TEST_F(LicenseCoordinatorTests, run_sharedLeaseForOtherMachine_sendsRequest)
+{
+  LicenseCoordinator coordinator;
+  writeSharedEntry({{"lease", validLease("other machine")}, {"time", QDateTime::currentSecsSinceEpoch()}});
+
+  run(coordinator);
+
+  EXPECT_EQ(1, m_requests);
+}
+
+TEST_F(LicenseCoordinatorTests, run_sharedLeaseWrongKey_sendsRequest)
+{
+  LicenseCoordinator coordinator;
+  const TestLeaseSigner forger;
+  const auto now = QDateTime::currentSecsSinceEpoch();
+  writeSharedEntry({{"lease", forger.lease(kSerialKey, kMachineSignature, now, now + 60)}, {"time", now}});
+
+  run(coordinator);
+
+  EXPECT_EQ(1, m_requests);
+}
+
+TEST_F(LicenseCoordinatorTests, run_newestOfSeveralUsers_reusesNewest)
+{
+  LicenseCoordinator coordinator;
+  const auto now = QDateTime::currentSecsSinceEpoch();
+  const auto older = validLease();
+  const auto newer = m_signer.lease(kSerialKey, kMachineSignature, now, now + kLeaseLifetimeSecs * 2);
+  writeSharedEntry({{"lease", older}, {"time", now - 60}}, "first");
+  writeSharedEntry({{"lease", newer}, {"time", now}}, "second");
+
+  const auto future = run(coordinator);
+
+  EXPECT_EQ(0, m_requests);
+  ASSERT_TRUE(future.isFinished());
+  EXPECT_EQ(newer, future.result().lease);
+}
+
+TEST_F(LicenseCoordinatorTests, run_noLeaseKey_sendsRequest)
+{
+  qunsetenv("SYNERGY_TEST_LEASE_PUBLIC_KEY");
+  if (!leasePublicKey().isEmpty()) {
+    GTEST_SKIP() << "built with a lease public key";
+  }
+
+  LicenseCoordinator coordinator;
+  writeSharedEntry({{"lease", validLease()}, {"time", QDateTime::currentSecsSinceEpoch()}});
+
+  run(coordinator);
+
+  EXPECT_EQ(1, m_requests);
+}
+
+#ifndef Q_OS_WIN
+TEST_F(LicenseCoordinatorTests, constructor_stateDir_sharedLikeTmp)
+{
+  LicenseCoordinator coordinator;
+
+  struct stat info = {};
+  ASSERT_EQ(0, stat(QFile::encodeName(stateDir()).constData(), &info));
+  EXPECT_EQ(01777, info.st_mode & 07777);
+}
+#endif
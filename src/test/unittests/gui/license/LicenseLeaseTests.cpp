@@ -0,0 +1,150 @@
+/*
+ * Synergy -- mouse and keyboard sharing utility
+ * Copyright (C) 2026 Symless Ltd.
+ *
+ * This package is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * found in the file LICENSE that should have accompanied this file.
+ *
+ * This package is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "shared/license/TestLeaseSigner.h"
+#include "synergy/gui/license/LicenseLease.h"
+
+#include <QJsonDocument>
+#include <QJsonObject>
+
+#include <gtest/gtest.h>
+
+using namespace synergy::gui::license;
+
+namespace {
+
+const auto kSerialKey = QStringLiteral("7B76313B70726F3B7D");
+const auto kMachineSignature = QStringLiteral("machine");
+const qint64 kIssuedAt = 1700000000;
+const qint64 kNotAfter = kIssuedAt + 4000;
+const auto kBase64Options = QByteArray::Base64UrlEncoding | QByteArray::OmitTrailingEquals;
+
+QJsonObject testPayload()
+{
+  return {
+      {"serialHash", LicenseLease::serialHash(kSerialKey)},
+      {"machineSignature", kMachineSignature},
+      {"issuedAt", kIssuedAt},
+      {"notAfter", kNotAfter},
+  };
+}
+
+} // namespace
+
+class LicenseLeaseTests : public testing::Test
+{
+protected:
+  TestLeaseSigner m_signer;
+};
+
+TEST_F(LicenseLeaseTests, fromToken_signedToken_hasPayload)
+{
+  const auto lease = LicenseLease::fromToken(m_signer.sign(testPayload()), m_signer.publicKey());
+
+  ASSERT_TRUE(lease.has_value());
+  EXPECT_EQ(kIssuedAt, lease->issuedAtSecs());
+  EXPECT_EQ(kNotAfter, lease->notAfterSecs());
+  EXPECT_TRUE(lease->isValidFor(kSerialKey, kMachineSignature, kIssuedAt));
+}
+
+TEST_F(LicenseLeaseTests, fromToken_payloadTampered_nothing)
+{
+  const auto token = m_signer.sign(testPayload());
+  auto payload = testPayload();
+  payload["notAfter"] = kNotAfter * 2;
+  const auto forged = QJsonDocument(payload).toJson(QJsonDocument::Compact).toBase64(kBase64Options);
+
+  const auto tampered = QString::fromLatin1(forged) + token.mid(token.indexOf('.'));
+
+  EXPECT_FALSE(LicenseLease::fromToken(tampered, m_signer.publicKey()).has_value());
+}
+
+TEST_F(LicenseLeaseTests, fromToken_otherSigningKey_nothing)
+{
+  const TestLeaseSigner other;
+
+  EXPECT_FALSE(LicenseLease::fromToken(other.sign(testPayload()), m_signer.publicKey()).has_value());
+}
+
+TEST_F(LicenseLeaseTests, fromToken_noPublicKey_nothing)
+{
+  EXPECT_FALSE(LicenseLease::fromToken(m_signer.sign(testPayload()), {}).has_value());
+}
+
+TEST_F(LicenseLeaseTests, fromToken_malformed_nothing)
+{
+  const auto token = m_signer.sign(testPayload());
+
+  EXPECT_FALSE(LicenseLease::fromToken("", m_signer.publicKey()).has_value());
+  EXPECT_FALSE(LicenseLease::fromToken("not a lease", m_signer.publicKey()).has_value());
+  EXPECT_FALSE(LicenseLease::fromToken(token + ".extra", m_signer.publicKey()).has_value());
+  EXPECT_FALSE(LicenseLease::fromToken(token.left(token.size() - 4), m_signer.publicKey()).has_value());
+}
+
+TEST_F(LicenseLeaseTests, fromToken_signedButIncomplete_nothing)
+{
+  auto payload = testPayload();
+  payload.remove("machineSignature");
+
+  EXPECT_FALSE(LicenseLease::fromToken(m_signer.sign(payload), m_signer.publicKey()).has_value());
+}
+
+TEST_F(LicenseLeaseTests, isValidFor_otherSerialKey_false)
+{
+  const auto lease = LicenseLease::fromToken(m_signer.sign(testPayload()), m_signer.publicKey());
+  ASSERT_TRUE(lease.has_value());
+
+  EXPECT_FALSE(lease->isValidFor("7B76313B62617369633B7D", kMachineSignature, kIssuedAt));
+}
+
+TEST_F(LicenseLeaseTests, isValidFor_otherMachine_false)
+{
+  const auto lease = LicenseLease::fromToken(m_signer.sign(testPayload()), m_signer.publicKey());
+  ASSERT_TRUE(lease.has_value());
+
+  EXPECT_FALSE(lease->isValidFor(kSerialKey, "other machine", kIssuedAt));
+}
+
+TEST_F(LicenseLeaseTests, isValidFor_expired_false)
+{
+  const auto lease = LicenseLease::fromToken(m_signer.sign(testPayload()), m_signer.publicKey());
+  ASSERT_TRUE(lease.has_value());
+
+  EXPECT_TRUE(lease->isValidFor(kSerialKey, kMachineSignature, kNotAfter - 1));
+  EXPECT_FALSE(lease->isValidFor(kSerialKey, kMachineSignature, kNotAfter));
+}
+
+TEST_F(LicenseLeaseTests, renewAtSecs_validLease_quarterLeft)
+{
+  const auto lease = LicenseLease::fromToken(m_signer.sign(testPayload()), m_signer.publicKey());
+  ASSERT_TRUE(lease.has_value());
+
+  EXPECT_EQ(kIssuedAt + 3000, lease->renewAtSecs());
+}
+
+TEST_F(LicenseLeaseTests, leasePublicKey_envVar_decoded)
+{
+#ifdef NDEBUG
+  GTEST_SKIP() << "lease public key can only be overridden by env var in debug builds";
+#endif // NDEBUG
+
+  qputenv("SYNERGY_TEST_LEASE_PUBLIC_KEY", m_signer.publicKey().toBase64());
+
+  EXPECT_EQ(m_signer.publicKey(), leasePublicKey());
+
+  qunsetenv("SYNERGY_TEST_LEASE_PUBLIC_KEY");
+}
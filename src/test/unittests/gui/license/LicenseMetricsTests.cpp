@@ -0,0 +1,69 @@
+/*
+ * Synergy -- mouse and keyboard sharing utility
+ * Copyright (C) 2026 Symless Ltd.
+ *
+ * This package is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * found in the file LICENSE that should have accompanied this file.
+ *
+ * This package is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "synergy/gui/license/LicenseMetrics.h"
+
+#include <gtest/gtest.h>
+
+using namespace std::chrono;
+using namespace synergy::gui::license;
+
+using Status = LicenseMetrics::Status;
+
+TEST(LicenseMetricsTests, prometheusText_results_countedByOperationAndResult)
+{
+  LicenseMetrics metrics;
+
+  metrics.recordAttempt(LicenseMetrics::Operation::kCheck);
+  metrics.recordResult(LicenseMetrics::Operation::kCheck, Status::kNetworkError);
+
+  const auto text = metrics.prometheusText(0);
+  EXPECT_TRUE(text.contains(R"(synergy_license_attempts_total{operation="check"} 1)"));
+  EXPECT_TRUE(text.contains(R"(synergy_license_results_total{operation="check",result="network_error"} 1)"));
+  EXPECT_TRUE(text.contains(R"(synergy_license_results_total{operation="activation",result="success"} 0)"));
+}
+
+TEST(LicenseMetricsTests, prometheusText_apiLatency_cumulativeBuckets)
+{
+  LicenseMetrics metrics;
+
+  metrics.recordApiRequest(LicenseMetrics::Endpoint::kActivate, Status::kSuccess, 80ms);
+  metrics.recordApiRequest(LicenseMetrics::Endpoint::kActivate, Status::kSuccess, 2s);
+
+  const auto text = metrics.prometheusText(0);
+  EXPECT_TRUE(text.contains(R"(synergy_license_api_latency_seconds_bucket{endpoint="activate",le="0.05"} 0)"));
+  EXPECT_TRUE(text.contains(R"(synergy_license_api_latency_seconds_bucket{endpoint="activate",le="0.1"} 1)"));
+  EXPECT_TRUE(text.contains(R"(synergy_license_api_latency_seconds_bucket{endpoint="activate",le="+Inf"} 2)"));
+  EXPECT_TRUE(text.contains(R"(synergy_license_api_latency_seconds_count{endpoint="activate"} 2)"));
+  EXPECT_TRUE(text.contains(R"(synergy_license_api_requests_total{endpoint="activate",status="success"} 2)"));
+}
+
+TEST(LicenseMetricsTests, prometheusText_inGrace_timeInGrace)
+{
+  LicenseMetrics metrics;
+
+  metrics.setGraceStart(1000);
+
+  EXPECT_TRUE(metrics.prometheusText(4600).contains("synergy_license_grace_seconds 3600\n"));
+}
+
+TEST(LicenseMetricsTests, prometheusText_notInGrace_zero)
+{
+  LicenseMetrics metrics;
+
+  EXPECT_TRUE(metrics.prometheusText(4600).contains("synergy_license_grace_seconds 0\n"));
+}
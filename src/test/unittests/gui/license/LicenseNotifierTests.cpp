@@ -0,0 +1,42 @@
+/*
+ * Synergy -- mouse and keyboard sharing utility
+ * Copyright (C) 2026 Symless Ltd.
+ *
+ * This package is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * found in the file LICENSE that should have accompanied this file.
+ *
+ * This package is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "synergy/gui/license/LicenseNotifier.h"
+
+#include <gtest/gtest.h>
+
+using namespace synergy::gui::license;
+
+TEST(LicenseNotifierTests, post_sameKey_coalesced)
+{
+  LicenseNotifier notifier;
+
+  notifier.post("status", LicenseNotifier::Level::kWarning, "License check failed", "first");
+  notifier.post("status", LicenseNotifier::Level::kWarning, "License check failed", "second");
+
+  EXPECT_EQ(1, notifier.pendingCount());
+}
+
+TEST(LicenseNotifierTests, post_differentKeys_bothQueued)
+{
+  LicenseNotifier notifier;
+
+  notifier.post("status", LicenseNotifier::Level::kWarning, "License check failed", "message");
+  notifier.post("activation", LicenseNotifier::Level::kWarning, "Activation failed", "message");
+
+  EXPECT_EQ(2, notifier.pendingCount());
+}
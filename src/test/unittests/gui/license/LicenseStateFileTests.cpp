@@ -0,0 +1,164 @@
+/*
+ * Synergy -- mouse and keyboard sharing utility
+ * Copyright (C) 2026 Symless Ltd.
+ *
+ * This package is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * found in the file LICENSE that should have accompanied this file.
+ *
+ * This package is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "synergy/gui/license/LicenseStateFile.h"
+
+#include <QFile>
+#include <QLockFile>
+#include <QTemporaryDir>
+
+#include <gtest/gtest.h>
+
+using namespace synergy::gui::license;
+
+namespace {
+
+LicenseStateFile::State testState(qint64 graceStartEpochSecs = 0)
+{
+  return {"7B76313B70726F3B7D", true, graceStartEpochSecs, "payload.signature", 1700000000};
+}
+
+} // namespace
+
+class LicenseStateFileTests : public testing::Test
+{
+protected:
+  QString path() const
+  {
+    return m_dir.filePath("license-state.bin");
+  }
+
+  QTemporaryDir m_dir;
+};
+
+TEST_F(LicenseStateFileTests, read_newFile_noState)
+{
+  LicenseStateFile file(path());
+  ASSERT_TRUE(file.open());
+
+  EXPECT_FALSE(file.read().has_value());
+  EXPECT_EQ(LicenseStateFile::kFileSize, QFile(path()).size());
+}
+
+TEST_F(LicenseStateFileTests, read_afterWrite_sameState)
+{
+  LicenseStateFile file(path());
+  ASSERT_TRUE(file.open());
+
+  ASSERT_TRUE(file.write(testState()));
+
+  EXPECT_EQ(testState(), file.read());
+}
+
+TEST_F(LicenseStateFileTests, read_manyWrites_latestState)
+{
+  LicenseStateFile file(path());
+  ASSERT_TRUE(file.open());
+
+  for (auto i = 1; i <= 5; i++) {
+    ASSERT_TRUE(file.write(testState(i)));
+  }
+
+  EXPECT_EQ(testState(5), file.read());
+}
+
+TEST_F(LicenseStateFileTests, read_otherInstance_seesWrites)
+{
+  LicenseStateFile writer(path());
+  LicenseStateFile reader(path());
+  ASSERT_TRUE(writer.open());
+  ASSERT_TRUE(reader.open());
+
+  ASSERT_TRUE(writer.write(testState(1)));
+  EXPECT_EQ(testState(1), reader.read());
+
+  ASSERT_TRUE(writer.write(testState(2)));
+  EXPECT_EQ(testState(2), reader.read());
+}
+
+TEST_F(LicenseStateFileTests, read_newestSlotCorrupt_previousState)
+{
+  {
+    LicenseStateFile file(path());
+    ASSERT_TRUE(file.open());
+    ASSERT_TRUE(file.write(testState(1)));
+    ASSERT_TRUE(file.write(testState(2)));
+  }
+
+  // The second write went to the second slot, at the end of the file.
+  QFile raw(path());
+  ASSERT_TRUE(raw.open(QIODevice::ReadWrite));
+  ASSERT_TRUE(raw.seek(LicenseStateFile::kFileSize - 100));
+  raw.write(QByteArray(10, 'x'));
+  raw.close();
+
+  LicenseStateFile file(path());
+  ASSERT_TRUE(file.open());
+  EXPECT_EQ(testState(1), file.read());
+}
+
+TEST_F(LicenseStateFileTests, open_notStateFile_startsAgain)
+{
+  QFile raw(path());
+  ASSERT_TRUE(raw.open(QIODevice::WriteOnly));
+  raw.write("[General]\nactivated=true\n");
+  raw.close();
+
+  LicenseStateFile file(path());
+  ASSERT_TRUE(file.open());
+
+  EXPECT_FALSE(file.read().has_value());
+}
+
+TEST_F(LicenseStateFileTests, write_leaseTooLong_returnsFalse)
+{
+  LicenseStateFile file(path());
+  ASSERT_TRUE(file.open());
+  auto state = testState();
+  state.lease = QString(LicenseStateFile::kMaxLeaseBytes + 1, 'a');
+
+  EXPECT_FALSE(file.write(state));
+}
+
+TEST_F(LicenseStateFileTests, write_lockHeld_returnsFalse)
+{
+  LicenseStateFile file(path());
+  ASSERT_TRUE(file.open());
+  ASSERT_TRUE(file.write(testState(1)));
+
+  QLockFile lock(path() + ".lock");
+  ASSERT_TRUE(lock.tryLock(0));
+
+  EXPECT_FALSE(file.write(testState(2)));
+  EXPECT_EQ(testState(1), file.read());
+}
+
+TEST_F(LicenseStateFileTests, write_done_lockReleased)
+{
+  LicenseStateFile file(path());
+  ASSERT_TRUE(file.open());
+
+  ASSERT_TRUE(file.write(testState()));
+
+  QLockFile lock(path() + ".lock");
+  EXPECT_TRUE(lock.tryLock(0));
+}
+
+TEST(LicenseStateFileStaticTests, pathFor_settingsFile_sameDir)
+{
+  EXPECT_EQ("/tmp/settings/license-state.bin", LicenseStateFile::pathFor("/tmp/settings/Synergy.conf"));
+}
@@ -0,0 +1,55 @@
+/*
+ * Synergy -- mouse and keyboard sharing utility
+ * Copyright (C) 2026 Symless Ltd.
+ *
+ * This package is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * found in the file LICENSE that should have accompanied this file.
+ *
+ * This package is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "synergy/gui/license/LicenseStatusServer.h"
+
+#include <QJsonDocument>
+#include <QJsonObject>
+
+#include <gtest/gtest.h>
+
+using namespace synergy::gui::license;
+
+TEST(LicenseStatusServerTests, toJson_notTimeLimited_nullDaysLeft)
+{
+  LicenseStatusServer::Status status;
+  status.edition = "Synergy 1 Pro";
+  status.valid = true;
+
+  const auto json = status.toJson();
+
+  EXPECT_TRUE(json.endsWith('\n'));
+  EXPECT_FALSE(json.trimmed().contains('\n'));
+  const auto object = QJsonDocument::fromJson(json).object();
+  EXPECT_EQ("Synergy 1 Pro", object["edition"].toString());
+  EXPECT_TRUE(object["valid"].toBool());
+  EXPECT_TRUE(object["daysLeft"].isNull());
+}
+
+TEST(LicenseStatusServerTests, snapshot_afterPublish_latestStatus)
+{
+  LicenseStatusServer server;
+  LicenseStatusServer::Status status;
+  status.daysLeft = 12;
+  status.lastCheckResult = "network_error";
+
+  server.publish(status);
+
+  const auto object = QJsonDocument::fromJson(server.snapshot()).object();
+  EXPECT_EQ(12, object["daysLeft"].toInteger());
+  EXPECT_EQ("network_error", object["lastCheckResult"].toString());
+}
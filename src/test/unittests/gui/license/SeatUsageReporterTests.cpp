@@ -0,0 +1,151 @@
+/*
+ * Synergy -- mouse and keyboard sharing utility
+ * Copyright (C) 2026 Symless Ltd.
+ *
+ * This package is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * found in the file LICENSE that should have accompanied this file.
+ *
+ * This package is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "synergy/gui/license/SeatUsageReporter.h"
+
+#include <QCborArray>
+#include <QTemporaryDir>
+
+#include <gtest/gtest.h>
+
+using namespace synergy::gui::license;
+
+class SeatUsageReporterTests : public testing::Test
+{
+protected:
+  QCborMap buildHeartbeat()
+  {
+    return m_reporter.buildHeartbeat();
+  }
+
+  static QString signature(const QString &name)
+  {
+    return SeatUsageReporter::clientSignature(name);
+  }
+
+  static QSet<QString> toSet(const QCborValue &array)
+  {
+    QSet<QString> set;
+    for (const auto &value : array.toArray()) {
+      set.insert(value.toString());
+    }
+    return set;
+  }
+
+  QTemporaryDir m_dir;
+  SeatUsageReporter m_reporter{
+      [](const QCborArray &) { return QFuture<LicenseApiClient::Result>(); }, m_dir.filePath("seat-heartbeats.jsonl")
+  };
+};
+
+TEST_F(SeatUsageReporterTests, handleLogLine_clientConnected_counted)
+{
+  m_reporter.handleLogLine(R"([2026-10-18T09:00:00] NOTE: client "desk-1" has connected)");
+  m_reporter.handleLogLine(R"([2026-10-18T09:00:01] NOTE: client "desk 2" has connected)");
+
+  const auto heartbeat = buildHeartbeat();
+
+  EXPECT_EQ(2, heartbeat[QStringLiteral("current")].toInteger());
+  EXPECT_EQ(QSet<QString>({signature("desk-1"), signature("desk 2")}), toSet(heartbeat[QStringLiteral("machines")]));
+}
+
+TEST_F(SeatUsageReporterTests, handleLogLine_connectedTwice_oneSeat)
+{
+  m_reporter.handleLogLine(R"(NOTE: client "desk-1" has connected)");
+  m_reporter.handleLogLine(R"(NOTE: client "desk-1" has connected)");
+  m_reporter.handleLogLine(R"(NOTE: client "desk-1" has disconnected)");
+
+  const auto heartbeat = buildHeartbeat();
+
+  EXPECT_EQ(0, heartbeat[QStringLiteral("current")].toInteger());
+  EXPECT_EQ(1, heartbeat[QStringLiteral("peak")].toInteger());
+}
+
+TEST_F(SeatUsageReporterTests, handleLogLine_otherLines_ignored)
+{
+  m_reporter.handleLogLine(R"(NOTE: started server, waiting for clients)");
+  m_reporter.handleLogLine(R"(WARNING: client "desk-1" is dead)");
+  m_reporter.handleLogLine(R"(NOTE: client "" has connected)");
+
+  EXPECT_EQ(0, buildHeartbeat()[QStringLiteral("current")].toInteger());
+}
+
+TEST_F(SeatUsageReporterTests, buildHeartbeat_afterFull_onlyChanges)
+{
+  m_reporter.handleLogLine(R"(NOTE: client "desk-1" has connected)");
+  m_reporter.handleLogLine(R"(NOTE: client "desk-2" has connected)");
+  buildHeartbeat();
+  m_reporter.handleLogLine(R"(NOTE: client "desk-2" has disconnected)");
+  m_reporter.handleLogLine(R"(NOTE: client "desk-3" has connected)");
+
+  const auto heartbeat = buildHeartbeat();
+
+  EXPECT_FALSE(heartbeat.contains(QStringLiteral("machines")));
+  EXPECT_EQ(QSet<QString>({signature("desk-3")}), toSet(heartbeat[QStringLiteral("added")]));
+  EXPECT_EQ(QSet<QString>({signature("desk-2")}), toSet(heartbeat[QStringLiteral("removed")]));
+}
+
+TEST_F(SeatUsageReporterTests, reset_clientsConnected_seatsFreedPeakKept)
+{
+  m_reporter.handleLogLine(R"(NOTE: client "desk-1" has connected)");
+  m_reporter.handleLogLine(R"(NOTE: client "desk-2" has connected)");
+  buildHeartbeat();
+  m_reporter.handleLogLine(R"(NOTE: client "desk-3" has connected)");
+
+  m_reporter.reset();
+  const auto heartbeat = buildHeartbeat();
+
+  EXPECT_EQ(0, heartbeat[QStringLiteral("current")].toInteger());
+  EXPECT_EQ(3, heartbeat[QStringLiteral("peak")].toInteger());
+  EXPECT_EQ(QSet<QString>({signature("desk-1"), signature("desk-2")}), toSet(heartbeat[QStringLiteral("removed")]));
+}
+
+TEST_F(SeatUsageReporterTests, reset_clientReconnects_countedAgain)
+{
+  m_reporter.handleLogLine(R"(NOTE: client "desk-1" has connected)");
+  m_reporter.reset();
+
+  m_reporter.handleLogLine(R"(NOTE: client "desk-1" has connected)");
+
+  EXPECT_EQ(1, buildHeartbeat()[QStringLiteral("current")].toInteger());
+}
+
+TEST_F(SeatUsageReporterTests, handleLogLine_overSeatLimit_countedAsOverLimit)
+{
+  m_reporter.setSeatLimit(1);
+  m_reporter.handleLogLine(R"(NOTE: client "desk-1" has connected)");
+  m_reporter.handleLogLine(R"(NOTE: client "desk-2" has connected)");
+
+  const auto heartbeat = buildHeartbeat();
+
+  EXPECT_EQ(2, heartbeat[QStringLiteral("current")].toInteger());
+  EXPECT_EQ(1, heartbeat[QStringLiteral("peak")].toInteger());
+  EXPECT_EQ(1, heartbeat[QStringLiteral("overLimit")].toInteger());
+}
+
+TEST_F(SeatUsageReporterTests, handleLogLine_seatFreed_overLimitClientTakesIt)
+{
+  m_reporter.setSeatLimit(1);
+  m_reporter.handleLogLine(R"(NOTE: client "desk-1" has connected)");
+  m_reporter.handleLogLine(R"(NOTE: client "desk-2" has connected)");
+  m_reporter.handleLogLine(R"(NOTE: client "desk-1" has disconnected)");
+
+  const auto heartbeat = buildHeartbeat();
+
+  EXPECT_EQ(1, heartbeat[QStringLiteral("current")].toInteger());
+  EXPECT_FALSE(heartbeat.contains(QStringLiteral("overLimit")));
+}
@@ -0,0 +1,86 @@
+/*
+ * Synergy -- mouse and keyboard sharing utility
+ * Copyright (C) 2026 Symless Ltd.
+ *
+ * This package is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * found in the file LICENSE that should have accompanied this file.
+ *
+ * This package is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "synergy/gui/license/license_wire.h"
+
+#include <gtest/gtest.h>
+
+using namespace synergy::gui::license;
+
+namespace {
+
+QCborMap testMessage()
+{
+  QCborMap message;
+  message[QStringLiteral("status")] = QStringLiteral("success");
+  message[QStringLiteral("isServer")] = true;
+  return message;
+}
+
+} // namespace
+
+TEST(license_wire_tests, encodeMessage_json_isCompact)
+{
+  const auto encoded = encodeMessage(testMessage(), WireFormat::kJson);
+
+  EXPECT_FALSE(encoded.contains('\n'));
+  EXPECT_FALSE(encoded.contains(' '));
+}
+
+TEST(license_wire_tests, decodeMessage_jsonRoundTrip_sameMessage)
+{
+  bool ok = false;
+
+  const auto decoded = decodeMessage(encodeMessage(testMessage(), WireFormat::kJson), WireFormat::kJson, &ok);
+
+  EXPECT_TRUE(ok);
+  EXPECT_EQ(testMessage(), decoded);
+}
+
+TEST(license_wire_tests, decodeMessage_cborRoundTrip_sameMessage)
+{
+  bool ok = false;
+
+  const auto decoded = decodeMessage(encodeMessage(testMessage(), WireFormat::kCbor), WireFormat::kCbor, &ok);
+
+  EXPECT_TRUE(ok);
+  EXPECT_EQ(testMessage(), decoded);
+}
+
+TEST(license_wire_tests, encodeMessage_cbor_smallerThanJson)
+{
+  const auto json = encodeMessage(testMessage(), WireFormat::kJson);
+  const auto cbor = encodeMessage(testMessage(), WireFormat::kCbor);
+
+  EXPECT_LT(cbor.size(), json.size());
+}
+
+TEST(license_wire_tests, decodeMessage_invalidBody_notOk)
+{
+  bool ok = true;
+
+  decodeMessage("not json", WireFormat::kJson, &ok);
+
+  EXPECT_FALSE(ok);
+}
+
+TEST(license_wire_tests, responseWireFormat_cborWithParams_isCbor)
+{
+  EXPECT_EQ(WireFormat::kCbor, responseWireFormat("application/cbor; charset=binary"));
+  EXPECT_EQ(WireFormat::kJson, responseWireFormat("application/json"));
+  EXPECT_EQ(WireFormat::kJson, responseWireFormat(""));
+}
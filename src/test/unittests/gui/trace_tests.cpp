@@ -0,0 +1,101 @@
+/*
+ * Synergy -- mouse and keyboard sharing utility
+ * Copyright (C) 2026 Symless Ltd.
+ *
+ * This package is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * found in the file LICENSE that should have accompanied this file.
+ *
+ * This package is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "synergy/gui/trace.h"
+
+#include <QFile>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QTemporaryDir>
+
+#include <algorithm>
+#include <gtest/gtest.h>
+#include <thread>
+
+using namespace synergy::gui;
+
+namespace {
+
+QJsonArray writeAndReadEvents()
+{
+  QTemporaryDir dir;
+  const auto path = dir.filePath("trace.json");
+  EXPECT_TRUE(trace::writeFile(path));
+
+  QFile file(path);
+  EXPECT_TRUE(file.open(QIODevice::ReadOnly));
+  return QJsonDocument::fromJson(file.readAll()).object()["traceEvents"].toArray();
+}
+
+bool hasEvent(const QJsonArray &events, const QString &name)
+{
+  return std::any_of(events.begin(), events.end(), [&name](const QJsonValue &event) {
+    return event["name"].toString() == name;
+  });
+}
+
+} // namespace
+
+TEST(trace_tests, span_disabled_notRecorded)
+{
+  trace::setEnabled(false);
+
+  { trace::Span span("trace_tests::disabled"); }
+
+  EXPECT_FALSE(hasEvent(writeAndReadEvents(), "trace_tests::disabled"));
+}
+
+TEST(trace_tests, span_enabled_writtenAsCompleteEvent)
+{
+  trace::setEnabled(true);
+
+  { trace::Span span("trace_tests::enabled"); }
+  trace::setEnabled(false);
+
+  const auto events = writeAndReadEvents();
+  ASSERT_TRUE(hasEvent(events, "trace_tests::enabled"));
+  for (const auto &event : events) {
+    if (event["name"].toString() == "trace_tests::enabled") {
+      EXPECT_EQ("X", event["ph"].toString());
+      EXPECT_GE(event["dur"].toInteger(), 0);
+    }
+  }
+}
+
+TEST(trace_tests, span_otherThread_recordedOnOwnThread)
+{
+  trace::setEnabled(true);
+
+  std::thread([] { trace::Span span("trace_tests::otherThread"); }).join();
+  { trace::Span span("trace_tests::thisThread"); }
+  trace::setEnabled(false);
+
+  const auto events = writeAndReadEvents();
+  qint64 otherTid = -1;
+  qint64 thisTid = -1;
+  for (const auto &event : events) {
+    if (event["name"].toString() == "trace_tests::otherThread") {
+      otherTid = event["tid"].toInteger();
+    } else if (event["name"].toString() == "trace_tests::thisThread") {
+      thisTid = event["tid"].toInteger();
+    }
+  }
+  ASSERT_NE(-1, otherTid);
+  ASSERT_NE(-1, thisTid);
+  EXPECT_NE(otherTid, thisTid);
+}
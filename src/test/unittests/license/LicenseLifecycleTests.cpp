@@ -0,0 +1,219 @@
+/*
+ * Synergy -- mouse and keyboard sharing utility
+ * Copyright (C) 2026 Symless Ltd.
+ *
+ * This package is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * found in the file LICENSE that should have accompanied this file.
+ *
+ * This package is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "shared/license/LicenseSimulator.h"
+#include "shared/license/VirtualClock.h"
+#include "synergy/license/LicenseLifecycle.h"
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <vector>
+
+using namespace std::chrono;
+using namespace synergy::license;
+
+using State = LicenseLifecycle::State;
+using Response = LicenseSimulator::Response;
+
+const auto kStart = system_clock::time_point{days{20000}};
+const auto kGracePeriod = days{14};
+
+SerialKey makeSerialKey(Product::Edition edition, const std::string &type = "")
+{
+  SerialKey serialKey("");
+  serialKey.isValid = true;
+  serialKey.product = Product(edition);
+  if (!type.empty()) {
+    serialKey.type.setType(type);
+    serialKey.warnTime = kStart + days{20};
+    serialKey.expireTime = kStart + days{30};
+  }
+  return serialKey;
+}
+
+LicenseSimulator::Server failBetween(days from, days to)
+{
+  return [from, to](std::size_t, system_clock::time_point now) {
+    const auto failing = now >= kStart + from && now < kStart + to;
+    return failing ? Response::kFailed : Response::kSuccess;
+  };
+}
+
+TEST(LicenseLifecycleTests, checkFailed_notInGrace_startsGrace)
+{
+  VirtualClock clock(kStart);
+  LicenseLifecycle lifecycle(makeSerialKey(Product::Edition::kBusiness), kGracePeriod, [&] { return clock.now(); });
+  lifecycle.activate();
+
+  EXPECT_FALSE(lifecycle.checkFailed());
+
+  EXPECT_EQ(lifecycle.state(), State::kGracePeriod);
+  EXPECT_EQ(lifecycle.graceStart(), kStart);
+}
+
+TEST(LicenseLifecycleTests, checkFailed_graceExpired_disables)
+{
+  VirtualClock clock(kStart);
+  LicenseLifecycle lifecycle(makeSerialKey(Product::Edition::kBusiness), kGracePeriod, [&] { return clock.now(); });
+  lifecycle.activate();
+  lifecycle.checkFailed();
+  clock.runFor(kGracePeriod);
+
+  EXPECT_TRUE(lifecycle.checkFailed());
+
+  EXPECT_EQ(lifecycle.state(), State::kDisabled);
+  EXPECT_FALSE(lifecycle.isActivated());
+}
+
+TEST(LicenseLifecycleTests, activate_afterDisabled_clearsGraceAndDisabled)
+{
+  VirtualClock clock(kStart);
+  LicenseLifecycle lifecycle(makeSerialKey(Product::Edition::kBusiness), kGracePeriod, [&] { return clock.now(); });
+  lifecycle.disable();
+
+  lifecycle.activate();
+
+  EXPECT_EQ(lifecycle.state(), State::kActive);
+  EXPECT_FALSE(lifecycle.isInGracePeriod());
+}
+
+TEST(LicenseLifecycleTests, state_expiredInGrace_expiredWins)
+{
+  VirtualClock clock(kStart);
+  LicenseLifecycle lifecycle(
+      makeSerialKey(Product::Edition::kBusiness, "subscription"), kGracePeriod, [&] { return clock.now(); }
+  );
+  lifecycle.activate();
+  lifecycle.checkFailed();
+
+  clock.runFor(days{30});
+
+  EXPECT_EQ(lifecycle.state(), State::kExpired);
+}
+
+TEST(LicenseLifecycleTests, isGracePeriodExpired_exactlyGracePeriod_true)
+{
+  EXPECT_TRUE(LicenseLifecycle::isGracePeriodExpired(kStart, kStart + kGracePeriod, kGracePeriod));
+  EXPECT_FALSE(LicenseLifecycle::isGracePeriodExpired(kStart, kStart + kGracePeriod - seconds{1}, kGracePeriod));
+}
+
+TEST(LicenseLifecycleTests, virtualClock_timers_fireInDueOrder)
+{
+  VirtualClock clock(kStart);
+  std::vector<int> fired;
+  clock.scheduleAfter(hours{2}, [&] { fired.push_back(2); });
+  clock.scheduleAfter(hours{1}, [&] { fired.push_back(1); });
+  const auto canceled = clock.scheduleAfter(hours{1}, [&] { fired.push_back(0); });
+  clock.cancel(canceled);
+
+  EXPECT_EQ(clock.runFor(days{1}), 2);
+
+  EXPECT_EQ(fired, (std::vector<int>{1, 2}));
+  EXPECT_EQ(clock.now(), kStart + days{1});
+  EXPECT_EQ(clock.pending(), 0);
+}
+
+TEST(LicenseLifecycleTests, simulate_trial_warnsThenExpires)
+{
+  VirtualClock clock(kStart);
+  LicenseSimulator simulator(clock, {}, failBetween(days{0}, days{0}));
+  simulator.add(makeSerialKey(Product::Edition::kPro, "trial"));
+
+  clock.runFor(days{60});
+
+  const auto transitions = simulator.transitionsOf(0);
+  ASSERT_EQ(transitions.size(), 3);
+  EXPECT_EQ(transitions[0].to, State::kActive);
+  EXPECT_EQ(transitions[1].to, State::kExpiringSoon);
+  EXPECT_EQ(transitions[1].at, kStart + days{20});
+  EXPECT_EQ(transitions[2].to, State::kExpired);
+  EXPECT_EQ(transitions[2].at, kStart + days{30});
+}
+
+TEST(LicenseLifecycleTests, simulate_checksFailPastGrace_disablesThenRestores)
+{
+  VirtualClock clock(kStart);
+  LicenseSimulator simulator(clock, {}, failBetween(days{10}, days{40}));
+  simulator.add(makeSerialKey(Product::Edition::kBusiness));
+
+  clock.runFor(days{90});
+
+  const auto transitions = simulator.transitionsOf(0);
+  ASSERT_EQ(transitions.size(), 4);
+  EXPECT_EQ(transitions[0].to, State::kActive);
+  EXPECT_EQ(transitions[1].to, State::kGracePeriod);
+  EXPECT_EQ(transitions[1].at, kStart + days{10});
+  EXPECT_EQ(transitions[2].to, State::kDisabled);
+  EXPECT_EQ(transitions[2].at, kStart + days{10} + kGracePeriod);
+  EXPECT_EQ(transitions[3].to, State::kActive);
+  EXPECT_EQ(transitions[3].at, kStart + days{40});
+}
+
+TEST(LicenseLifecycleTests, simulate_checksRecoverWithinGrace_neverDisabled)
+{
+  VirtualClock clock(kStart);
+  LicenseSimulator simulator(clock, {}, failBetween(days{10}, days{12}));
+  simulator.add(makeSerialKey(Product::Edition::kBusiness));
+
+  clock.runFor(days{90});
+
+  const auto transitions = simulator.transitionsOf(0);
+  ASSERT_EQ(transitions.size(), 3);
+  EXPECT_EQ(transitions[1].to, State::kGracePeriod);
+  EXPECT_EQ(transitions[2].to, State::kActive);
+  EXPECT_EQ(transitions[2].at, kStart + days{12});
+}
+
+TEST(LicenseLifecycleTests, simulate_personalLicense_neverChecked)
+{
+  VirtualClock clock(kStart);
+  LicenseSimulator simulator(clock, {}, failBetween(days{10}, days{40}));
+  simulator.add(makeSerialKey(Product::Edition::kPro));
+
+  clock.runFor(days{90});
+
+  EXPECT_EQ(simulator.requests(), 1);
+  EXPECT_EQ(simulator.state(0), State::kActive);
+}
+
+TEST(LicenseLifecycleTests, simulate_thousandsOfLicenses_eachFollowsItsServer)
+{
+  const std::size_t licenses = 5000;
+  VirtualClock clock(kStart);
+  const auto failing = failBetween(days{30}, days{60});
+  LicenseSimulator simulator(clock, {}, [&failing](std::size_t license, system_clock::time_point now) {
+    return license % 7 == 0 ? failing(license, now) : Response::kSuccess;
+  });
+  for (std::size_t i = 0; i < licenses; i++) {
+    simulator.add(makeSerialKey(Product::Edition::kBusiness));
+  }
+
+  clock.runFor(days{180});
+
+  std::size_t disabled = 0;
+  for (const auto &transition : simulator.transitions()) {
+    if (transition.to == State::kDisabled) {
+      EXPECT_EQ(transition.license % 7, 0);
+      disabled++;
+    }
+  }
+  EXPECT_EQ(disabled, (licenses + 6) / 7);
+  for (std::size_t i = 0; i < licenses; i++) {
+    EXPECT_EQ(simulator.state(i), State::kActive);
+  }
+}
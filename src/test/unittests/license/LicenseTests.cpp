@@ -196,3 +196,29 @@ TEST_F(LicenseTests, isExpired_expiredV2SubscriptionBasicSerial_returnTrue)
   EXPECT_TRUE(license.isSubscription());
   EXPECT_TRUE(license.isExpired());
 }
+
+TEST_F(LicenseTests, serialKey_v2WithSeats_parsesSeats)
+{
+  // {v2;trial;basic;Bob;1;email;company name;1;86400}
+  License license("7B76323B747269616C3B62617369633B426F623B313B656D61696C3B636"
+                  "F6D70616E79206E616D653B313B38363430307D");
+
+  EXPECT_EQ(license.serialKey().seats, 1);
+}
+
+TEST_F(LicenseTests, serialKey_v3WithSeats_parsesSeats)
+{
+  // {v3;online;subscription;business;Bob;25;email;company name;0;86400}
+  License license("7B76333B6F6E6C696E653B737562736372697074696F6E3B627573696E6573733B426F623B32353B656D61"
+                  "696C3B636F6D70616E79206E616D653B303B38363430307D");
+
+  EXPECT_EQ(license.serialKey().seats, 25);
+}
+
+TEST_F(LicenseTests, serialKey_v1WithoutSeats_noSeatLimit)
+{
+  // {v1;basic;Bob;;email;company name;0;86400}
+  License license("7B76313B62617369633B426F623B3B656D61696C3B636F6D70616E79206E616D653B303B38363430307D");
+
+  EXPECT_FALSE(license.serialKey().seats.has_value());
+}
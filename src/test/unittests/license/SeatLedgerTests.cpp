@@ -0,0 +1,142 @@
+/*
+ * Synergy -- mouse and keyboard sharing utility
+ * Copyright (C) 2026 Symless Ltd.
+ *
+ * This package is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * found in the file LICENSE that should have accompanied this file.
+ *
+ * This package is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "synergy/license/SeatLedger.h"
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+using namespace synergy::license;
+
+TEST(SeatLedgerTests, tryAcquire_underLimit_accepted)
+{
+  SeatLedger ledger(2);
+
+  EXPECT_TRUE(ledger.tryAcquire());
+  EXPECT_TRUE(ledger.tryAcquire());
+  EXPECT_EQ(ledger.snapshot().used, 2);
+}
+
+TEST(SeatLedgerTests, tryAcquire_atLimit_rejected)
+{
+  SeatLedger ledger(1);
+  ledger.tryAcquire();
+
+  EXPECT_FALSE(ledger.tryAcquire());
+  EXPECT_EQ(ledger.snapshot().rejected, 1);
+}
+
+TEST(SeatLedgerTests, tryAcquire_noLimit_alwaysAccepted)
+{
+  SeatLedger ledger;
+
+  for (int i = 0; i < 1000; i++) {
+    EXPECT_TRUE(ledger.tryAcquire());
+  }
+  EXPECT_FALSE(ledger.snapshot().limit.has_value());
+}
+
+TEST(SeatLedgerTests, release_afterLimit_seatFreed)
+{
+  SeatLedger ledger(1);
+  ledger.tryAcquire();
+  ledger.release();
+
+  EXPECT_TRUE(ledger.tryAcquire());
+  EXPECT_EQ(ledger.snapshot().peak, 1);
+}
+
+TEST(SeatLedgerTests, release_noSeatsTaken_staysAtZero)
+{
+  SeatLedger ledger(1);
+  ledger.release();
+
+  EXPECT_EQ(ledger.snapshot().used, 0);
+}
+
+TEST(SeatLedgerTests, setLimit_belowUsed_keepsSeatsRejectsNew)
+{
+  SeatLedger ledger(3);
+  ledger.tryAcquire();
+  ledger.tryAcquire();
+  ledger.setLimit(1);
+
+  EXPECT_EQ(ledger.snapshot().used, 2);
+  EXPECT_FALSE(ledger.tryAcquire());
+}
+
+TEST(SeatLedgerTests, clear_seatsTaken_freedPeakKept)
+{
+  SeatLedger ledger(2);
+  ledger.tryAcquire();
+  ledger.tryAcquire();
+
+  ledger.clear();
+
+  EXPECT_EQ(ledger.snapshot().used, 0);
+  EXPECT_EQ(ledger.snapshot().peak, 2);
+  EXPECT_TRUE(ledger.tryAcquire());
+}
+
+TEST(SeatLedgerTests, restartPeak_afterRelease_startsFromSeatsInUse)
+{
+  SeatLedger ledger;
+  ledger.tryAcquire();
+  ledger.tryAcquire();
+  ledger.tryAcquire();
+  ledger.release();
+
+  EXPECT_EQ(ledger.restartPeak(), 3);
+  EXPECT_EQ(ledger.snapshot().peak, 2);
+}
+
+TEST(SeatLedgerTests, tryAcquire_concurrentReconnects_neverExceedsLimit)
+{
+  const auto kLimit = 50;
+  const auto kThreads = 8;
+  const auto kAttempts = 10000;
+  SeatLedger ledger(kLimit);
+
+  std::atomic_int maxSeen = 0;
+  std::vector<std::thread> threads;
+  for (int t = 0; t < kThreads; t++) {
+    threads.emplace_back([&ledger, &maxSeen] {
+      for (int i = 0; i < kAttempts; i++) {
+        if (ledger.tryAcquire()) {
+          const auto used = ledger.snapshot().used;
+          auto seen = maxSeen.load();
+          while (used > seen && !maxSeen.compare_exchange_weak(seen, used)) {
+          }
+          ledger.release();
+        }
+      }
+    });
+  }
+
+  for (auto &thread : threads) {
+    thread.join();
+  }
+
+  const auto snapshot = ledger.snapshot();
+  EXPECT_LE(maxSeen.load(), kLimit);
+  EXPECT_LE(snapshot.peak, kLimit);
+  EXPECT_EQ(snapshot.used, 0);
+  EXPECT_EQ(snapshot.accepted + snapshot.rejected, static_cast<std::uint64_t>(kThreads * kAttempts));
+}
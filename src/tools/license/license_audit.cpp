@@ -0,0 +1,71 @@
+/*
+ * Synergy -- mouse and keyboard sharing utility
+ * Copyright (C) 2026 Symless Ltd.
+ *
+ * This package is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * found in the file LICENSE that should have accompanied this file.
+ *
+ * This package is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+// Decodes a license audit log, e.g. one sent in with a support case.
+//
+// Usage: synergy-license-audit [--json] [path]
+
+#include "synergy/gui/constants.h"
+#include "synergy/gui/license/LicenseAuditLog.h"
+
+#include <QCommandLineParser>
+#include <QCoreApplication>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QTextStream>
+
+using namespace synergy::gui::license;
+
+int main(int argc, char **argv)
+{
+  QCoreApplication app(argc, argv);
+  QCoreApplication::setApplicationName("synergy-license-audit");
+
+  QCommandLineParser parser;
+  parser.setApplicationDescription("Decode a license audit log to text or JSON");
+  parser.addHelpOption();
+  parser.addOption({"json", "Print a JSON array instead of one line per event."});
+  parser.addPositionalArgument("path", "Log file to decode (default: this user's log).", "[path]");
+  parser.process(app);
+
+  // The default log is in the GUI's data dir, which is named after the GUI, not this tool.
+  QCoreApplication::setOrganizationName(synergy::gui::kGuiOrganizationName);
+  QCoreApplication::setApplicationName(synergy::gui::kGuiApplicationName);
+
+  const auto args = parser.positionalArguments();
+  const auto path = args.isEmpty() ? LicenseAuditLog::defaultPath() : args.first();
+  const auto records = LicenseAuditLog::readFile(path);
+  if (!records.has_value()) {
+    qWarning().noquote() << "not a license audit log:" << path;
+    return 1;
+  }
+
+  QTextStream out(stdout);
+  if (parser.isSet("json")) {
+    QJsonArray events;
+    for (const auto &record : records.value()) {
+      events.append(LicenseAuditLog::toJson(record));
+    }
+    out << QJsonDocument(events).toJson();
+    return 0;
+  }
+
+  for (const auto &record : records.value()) {
+    out << LicenseAuditLog::toText(record) << Qt::endl;
+  }
+  return 0;
+}
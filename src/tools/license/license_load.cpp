@@ -0,0 +1,348 @@
+/*
+ * Synergy -- mouse and keyboard sharing utility
+ * Copyright (C) 2026 Symless Ltd.
+ *
+ * This package is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * found in the file LICENSE that should have accompanied this file.
+ *
+ * This package is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+// Simulates a fleet of GUIs talking to the license API, to see how a change in client
+// behavior affects server load before it ships.
+//
+// Each simulated machine is a real `LicenseApiClient`, spread over a few worker threads.
+// Machines check in on an interval and back off on network errors using the client's
+// retry delay (`LicenseApiClient::retryDelay`); the report shows the request rate
+// (including the peak second, which is where retry storms show up), the retries, and
+// latency percentiles.
+//
+// Usage: synergy-license-load --clients 2000 --duration 60 [--mock --script behavior.json]
+
+#include "shared/license/LatencyStats.h"
+#include "shared/license/MockLicenseApi.h"
+#include "synergy/gui/constants.h"
+#include "synergy/gui/license/LicenseApiClient.h"
+
+#include <QCommandLineParser>
+#include <QCoreApplication>
+#include <QCryptographicHash>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QMap>
+#include <QRandomGenerator>
+#include <QThread>
+#include <QTimer>
+
+#include <algorithm>
+#include <memory>
+#include <vector>
+
+using namespace synergy::gui;
+using namespace synergy::gui::license;
+using namespace std::chrono;
+
+namespace {
+
+using Result = LicenseApiClient::Result;
+
+struct Options
+{
+  int clients = 1000;
+  int threads = 8;
+  int durationSecs = 60;
+  int intervalMs = 10000;
+  int rampMs = 0;
+  milliseconds retry = kLicenseApiRetryDelay;
+  milliseconds maxRetry = kLicenseApiMaxRetryDelay;
+  bool activate = false;
+  QString baseUrl;
+  QString jsonPath;
+};
+
+struct Machine
+{
+  LicenseApiClient *api = nullptr;
+  LicenseApiClient::Data data;
+  int failures = 0;
+};
+
+class LoadGenerator
+{
+public:
+  explicit LoadGenerator(const Options &options) : m_options(options)
+  {
+  }
+
+  ~LoadGenerator()
+  {
+    for (const auto thread : m_threads) {
+      thread->quit();
+      thread->wait();
+      delete thread;
+    }
+  }
+
+  void start()
+  {
+    for (int i = 0; i < m_options.threads; i++) {
+      auto thread = new QThread();
+      thread->setObjectName(QString("load-%1").arg(i));
+      thread->start();
+      m_threads.push_back(thread);
+    }
+
+    m_machines.resize(static_cast<std::size_t>(m_options.clients));
+    for (int i = 0; i < m_options.clients; i++) {
+      auto &machine = m_machines[static_cast<std::size_t>(i)];
+      machine.api = new LicenseApiClient();
+      machine.api->moveToThread(m_threads[static_cast<std::size_t>(i % m_options.threads)]);
+      QObject::connect(
+          m_threads[static_cast<std::size_t>(i % m_options.threads)], &QThread::finished, machine.api,
+          &QObject::deleteLater
+      );
+
+      const auto id = QString("load-machine-%1").arg(i).toUtf8();
+      machine.data = {
+          QCryptographicHash::hash(id, QCryptographicHash::Sha256).toHex(),
+          QCryptographicHash::hash(id + "-host", QCryptographicHash::Sha256).toHex(),
+          "7B76323B747269616C3B62617369633B426F623B313B656D61696C3B636F6D70616E79206E616D653B313B38363430307D",
+          "0.0.0-load",
+          "load-generator",
+          false
+      };
+    }
+
+    m_elapsed.start();
+    for (int i = 0; i < m_options.clients; i++) {
+      const auto delay = m_options.rampMs > 0 ? QRandomGenerator::global()->bounded(m_options.rampMs) : 0;
+      QTimer::singleShot(delay, &m_context, [this, i] { send(i, false); });
+    }
+
+    QTimer::singleShot(seconds{m_options.durationSecs}, &m_context, [this] { stop(); });
+  }
+
+private:
+  void send(int index, bool isRetry)
+  {
+    if (m_stopping) {
+      return;
+    }
+
+    auto &machine = m_machines[static_cast<std::size_t>(index)];
+    const auto second = static_cast<int>(m_elapsed.elapsed() / 1000);
+    m_perSecond[second]++;
+    m_sent++;
+    m_inFlight++;
+    if (isRetry) {
+      m_retries++;
+    }
+
+    const auto sentAt = m_elapsed.nsecsElapsed();
+    auto future = m_options.activate ? machine.api->activate(machine.data)
+                                     : machine.api->check(machine.data, QUrl(m_options.baseUrl + "/check"));
+    future.then(&m_context, [this, index, sentAt](const Result &result) {
+      handleResult(index, result, nanoseconds{m_elapsed.nsecsElapsed() - sentAt});
+    });
+  }
+
+  void handleResult(int index, const Result &result, nanoseconds latency)
+  {
+    m_inFlight--;
+    m_latency.add(duration_cast<microseconds>(latency));
+    m_statusCounts[Result::statusName(result.status)]++;
+
+    if (m_stopping) {
+      maybeFinish();
+      return;
+    }
+
+    auto &machine = m_machines[static_cast<std::size_t>(index)];
+    auto random = QRandomGenerator::global();
+    if (result.status == Result::Status::kNetworkError) {
+      machine.failures++;
+      const auto delay = LicenseApiClient::retryDelay(machine.failures, m_options.retry, m_options.maxRetry, *random);
+      QTimer::singleShot(delay, &m_context, [this, index] { send(index, true); });
+    } else {
+      machine.failures = 0;
+      const auto jitter = m_options.intervalMs / 10;
+      const auto delay = m_options.intervalMs + (jitter > 0 ? random->bounded(jitter) : 0);
+      QTimer::singleShot(delay, &m_context, [this, index] { send(index, false); });
+    }
+  }
+
+  void stop()
+  {
+    m_stopping = true;
+    m_runSecs = m_elapsed.elapsed() / 1000.0;
+    qInfo("load run finished, waiting for %d requests in flight", m_inFlight);
+
+    // Don't wait forever for requests the server is sitting on.
+    QTimer::singleShot(seconds{10}, &m_context, [this] { finish(); });
+    maybeFinish();
+  }
+
+  void maybeFinish()
+  {
+    if (m_inFlight == 0) {
+      finish();
+    }
+  }
+
+  void finish()
+  {
+    if (m_finished) {
+      return;
+    }
+    m_finished = true;
+
+    for (auto &machine : m_machines) {
+      machine.api->cancelAll();
+    }
+
+    report();
+    QCoreApplication::quit();
+  }
+
+  void report() const
+  {
+    const auto peak = std::max_element(m_perSecond.cbegin(), m_perSecond.cend());
+    const auto peakRate = peak == m_perSecond.cend() ? 0 : *peak;
+    const auto rate = m_runSecs > 0 ? m_sent / m_runSecs : 0;
+    const auto toMs = [](microseconds us) { return static_cast<double>(us.count()) / 1000.0; };
+
+    QJsonObject statuses;
+    for (auto it = m_statusCounts.cbegin(); it != m_statusCounts.cend(); ++it) {
+      statuses[it.key()] = static_cast<qint64>(it.value());
+    }
+
+    QJsonObject json{
+        {"clients", m_options.clients},
+        {"durationSecs", m_runSecs},
+        {"requests", static_cast<qint64>(m_sent)},
+        {"requestsPerSec", rate},
+        {"peakRequestsPerSec", peakRate},
+        {"retries", static_cast<qint64>(m_retries)},
+        {"retryRatio", m_sent > 0 ? static_cast<double>(m_retries) / m_sent : 0},
+        {"statuses", statuses},
+        {"latencyMs",
+         QJsonObject{
+             {"mean", toMs(m_latency.mean())},
+             {"p50", toMs(m_latency.percentile(50))},
+             {"p95", toMs(m_latency.percentile(95))},
+             {"p99", toMs(m_latency.percentile(99))},
+             {"max", toMs(m_latency.percentile(100))},
+         }},
+    };
+
+    qInfo(
+        "requests: %llu in %.1fs (%.1f/s, peak %d/s), retries: %llu", m_sent, m_runSecs, rate, peakRate, m_retries
+    );
+    qInfo(
+        "latency ms: p50 %.1f, p95 %.1f, p99 %.1f, max %.1f", toMs(m_latency.percentile(50)),
+        toMs(m_latency.percentile(95)), toMs(m_latency.percentile(99)), toMs(m_latency.percentile(100))
+    );
+    qInfo().noquote() << "statuses:" << QJsonDocument(statuses).toJson(QJsonDocument::Compact);
+
+    if (!m_options.jsonPath.isEmpty()) {
+      QFile file(m_options.jsonPath);
+      if (file.open(QIODevice::WriteOnly)) {
+        file.write(QJsonDocument(json).toJson());
+      } else {
+        qWarning().noquote() << "unable to write report:" << m_options.jsonPath;
+      }
+    }
+  }
+
+  Options m_options;
+  QObject m_context;
+  QElapsedTimer m_elapsed;
+  std::vector<QThread *> m_threads;
+  std::vector<Machine> m_machines;
+  LatencyStats m_latency;
+  QMap<int, int> m_perSecond;
+  QMap<QString, quint64> m_statusCounts;
+  quint64 m_sent = 0;
+  quint64 m_retries = 0;
+  int m_inFlight = 0;
+  double m_runSecs = 0;
+  bool m_stopping = false;
+  bool m_finished = false;
+};
+
+} // namespace
+
+int main(int argc, char **argv)
+{
+  QCoreApplication app(argc, argv);
+  QCoreApplication::setApplicationName("synergy-license-load");
+
+  QCommandLineParser parser;
+  parser.setApplicationDescription("License API load generator");
+  parser.addHelpOption();
+  parser.addOption({"url", "Base URL of the license API.", "url", "http://127.0.0.1:4200/synergy/api/product"});
+  parser.addOption({"mock", "Start a mock license API in this process and use that."});
+  parser.addOption({"script", "Behavior script for the mock license API.", "path"});
+  parser.addOption({"clients", "Number of simulated machines.", "count", "1000"});
+  parser.addOption({"threads", "Worker threads for the clients.", "count", "8"});
+  parser.addOption({"duration", "Seconds to run for.", "seconds", "60"});
+  parser.addOption({"interval", "Milliseconds between checks per machine.", "ms", "10000"});
+  parser.addOption({"ramp", "Spread machine start over this many milliseconds.", "ms", "0"});
+  parser.addOption(
+      {"retry", "First retry delay after a network error.", "ms",
+       QString::number(duration_cast<milliseconds>(kLicenseApiRetryDelay).count())}
+  );
+  parser.addOption(
+      {"max-retry", "Longest retry delay.", "ms",
+       QString::number(duration_cast<milliseconds>(kLicenseApiMaxRetryDelay).count())}
+  );
+  parser.addOption({"activate", "Send activations instead of checks."});
+  parser.addOption({"json", "Write the report to this file as JSON.", "path"});
+  parser.process(app);
+
+  Options options;
+  options.clients = std::max(1, parser.value("clients").toInt());
+  options.threads = std::max(1, parser.value("threads").toInt());
+  options.durationSecs = std::max(1, parser.value("duration").toInt());
+  options.intervalMs = parser.value("interval").toInt();
+  options.rampMs = parser.value("ramp").toInt();
+  options.retry = milliseconds{std::max(1, parser.value("retry").toInt())};
+  options.maxRetry = milliseconds{parser.value("max-retry").toInt()};
+  options.activate = parser.isSet("activate");
+  options.baseUrl = parser.value("url");
+  options.jsonPath = parser.value("json");
+
+  std::unique_ptr<MockLicenseApi> mock;
+  if (parser.isSet("mock")) {
+    mock = std::make_unique<MockLicenseApi>();
+    if (parser.isSet("script") && !mock->loadScript(parser.value("script"))) {
+      return 1;
+    }
+    if (!mock->listen()) {
+      return 1;
+    }
+    options.baseUrl = mock->url("check").section('/', 0, -2);
+  }
+
+  // Activation has no per-request URL, so it's pointed at the target the same way the
+  // GUI is in development.
+  qputenv("SYNERGY_TEST_API_URL_ACTIVATE", (options.baseUrl + "/activate").toUtf8());
+
+  qInfo(
+      "running %d clients on %d threads for %ds against %s", options.clients, options.threads, options.durationSecs,
+      qPrintable(options.baseUrl)
+  );
+
+  LoadGenerator generator(options);
+  generator.start();
+  return QCoreApplication::exec();
+}
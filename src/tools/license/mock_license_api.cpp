@@ -0,0 +1,72 @@
+/*
+ * Synergy -- mouse and keyboard sharing utility
+ * Copyright (C) 2026 Symless Ltd.
+ *
+ * This package is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * found in the file LICENSE that should have accompanied this file.
+ *
+ * This package is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+// Serves a fake license API on localhost, e.g. for `SYNERGY_TEST_API_URL_CHECK`.
+//
+// Usage: synergy-license-mock [--port 4200] [--script behavior.json] [--stats-interval 5]
+
+#include "shared/license/MockLicenseApi.h"
+
+#include <QCommandLineParser>
+#include <QCoreApplication>
+#include <QTimer>
+
+using namespace synergy::gui::license;
+
+int main(int argc, char **argv)
+{
+  QCoreApplication app(argc, argv);
+  QCoreApplication::setApplicationName("synergy-license-mock");
+
+  QCommandLineParser parser;
+  parser.setApplicationDescription("Mock license API server for local testing");
+  parser.addHelpOption();
+  parser.addOption({"port", "Port to listen on.", "port", "4200"});
+  parser.addOption({"script", "JSON file with the behavior of each endpoint.", "path"});
+  parser.addOption({"stats-interval", "Seconds between stats lines, or 0 for none.", "seconds", "5"});
+  parser.process(app);
+
+  MockLicenseApi api;
+  if (parser.isSet("script") && !api.loadScript(parser.value("script"))) {
+    return 1;
+  }
+
+  if (!api.listen(static_cast<quint16>(parser.value("port").toUInt()))) {
+    return 1;
+  }
+
+  qInfo().noquote() << "check url:" << api.url("check");
+  qInfo().noquote() << "activate url:" << api.url("activate");
+
+  const auto statsInterval = parser.value("stats-interval").toInt();
+  QTimer statsTimer;
+  quint64 lastRequests = 0;
+  QObject::connect(&statsTimer, &QTimer::timeout, [&api, &lastRequests, statsInterval] {
+    const auto stats = api.stats();
+    const auto rate = static_cast<double>(stats.requests - lastRequests) / statsInterval;
+    lastRequests = stats.requests;
+    qInfo(
+        "requests: %llu (%.1f/s), answered: %llu, errors: %llu, dropped: %llu", stats.requests, rate, stats.answered,
+        stats.errors, stats.dropped
+    );
+  });
+  if (statsInterval > 0) {
+    statsTimer.start(statsInterval * 1000);
+  }
+
+  return QCoreApplication::exec();
+}